@@ -0,0 +1,99 @@
+/*
+ * Address Registry for qOracle
+ * Interns Stacks-style address strings to dense 32-bit account ids
+ *
+ * Every address is hashed and stored once; token ledgers then index
+ * balances by AccountId so transfers never hash or compare strings.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef ADDRESS_REGISTRY_HPP
+#define ADDRESS_REGISTRY_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include "FlatHashMap.hpp"
+
+namespace qOracle {
+
+using AccountId = uint32_t;
+constexpr AccountId INVALID_ACCOUNT = std::numeric_limits<AccountId>::max();
+
+class AddressRegistry {
+private:
+    FlatHashMap<std::string, AccountId> ids;
+    std::vector<std::string> addresses;
+    std::atomic<size_t> count{0};   // addresses.size(), readable without the lock
+    mutable std::shared_mutex registry_mutex;
+
+public:
+    AddressRegistry() = default;
+    AddressRegistry(const AddressRegistry&) = delete;
+    AddressRegistry& operator=(const AddressRegistry&) = delete;
+
+    // Return the id for addr, assigning the next dense id if it is new
+    AccountId intern(const std::string& addr) {
+        size_t hash = ids.hash_of(addr);
+        {
+            std::shared_lock<std::shared_mutex> lock(registry_mutex);
+            auto it = ids.find(addr, hash);
+            if (it != ids.end()) return it->second;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(registry_mutex);
+        auto it = ids.find(addr, hash);
+        if (it != ids.end()) return it->second;
+
+        if (addresses.size() >= INVALID_ACCOUNT) {
+            throw std::length_error("Address registry exhausted");
+        }
+        AccountId id = static_cast<AccountId>(addresses.size());
+        addresses.push_back(addr);
+        ids.at_hashed(addr, hash) = id;
+        count.store(addresses.size(), std::memory_order_release);
+        return id;
+    }
+
+    // Lookup without inserting; INVALID_ACCOUNT if addr was never seen
+    AccountId find(const std::string& addr) const {
+        std::shared_lock<std::shared_mutex> lock(registry_mutex);
+        auto it = ids.find(addr);
+        return it != ids.end() ? it->second : INVALID_ACCOUNT;
+    }
+
+    // True if intern() has handed out id; lock-free, for per-transfer checks
+    bool contains(AccountId id) const {
+        return id < count.load(std::memory_order_acquire);
+    }
+
+    std::string address(AccountId id) const {
+        std::shared_lock<std::shared_mutex> lock(registry_mutex);
+        return id < addresses.size() ? addresses[id] : std::string();
+    }
+
+    size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(registry_mutex);
+        return addresses.size();
+    }
+
+    // Hash table plus interned strings; ids are never recycled
+    size_t memory_bytes() const {
+        std::shared_lock<std::shared_mutex> lock(registry_mutex);
+        size_t bytes = ids.memory_bytes() + addresses.capacity() * sizeof(std::string);
+        for (const auto& addr : addresses) {
+            if (addr.capacity() > sizeof(std::string)) bytes += addr.capacity() + 1;
+        }
+        return bytes;
+    }
+};
+
+} // namespace qOracle
+
+#endif // ADDRESS_REGISTRY_HPP
@@ -0,0 +1,296 @@
+/*
+ * Multi-Version Balance Snapshots for qOracle Token Ledgers
+ * Epoch-numbered, immutable views of a ledger for non-blocking reads
+ *
+ * Each publish() folds a set of balance changes into a persistent
+ * 16-way trie keyed by AccountId and numbers the result as the next
+ * epoch. Published nodes are never modified: a change copies the path
+ * from the root to its leaf and shares every other node with the
+ * previous epoch. A pinned Snapshot therefore reads and iterates its
+ * epoch without touching the ledger's stripes or blocking publishers.
+ *
+ * Nodes replaced while building epoch e are retired with e. Once every
+ * epoch before e has left the retention window and has no pinned
+ * readers, nothing can reach them and they are freed. A long-lived
+ * reader holds back reclamation, never the writers.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef BALANCE_SNAPSHOTS_HPP
+#define BALANCE_SNAPSHOTS_HPP
+
+#include <cstdint>
+#include <array>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <utility>
+#include "AddressRegistry.hpp"
+
+namespace qOracle {
+
+class BalanceSnapshots {
+private:
+    static constexpr size_t FANOUT_BITS = 4;
+    static constexpr size_t FANOUT = size_t(1) << FANOUT_BITS;
+    static constexpr size_t LEAF_LEVEL = 32 / FANOUT_BITS - 1;      // Levels 0..6 interior, 7 leaves
+
+    struct Node {
+        uint64_t born;                      // Epoch whose publish created the node
+        union {
+            std::array<const Node*, FANOUT> child;
+            std::array<uint64_t, FANOUT> balance;
+        };
+        explicit Node(uint64_t epoch) : born(epoch), balance{} {}
+    };
+    static_assert(sizeof(const Node*) == sizeof(uint64_t), "Node slots assume 64-bit pointers");
+
+    struct Version {
+        uint64_t epoch;
+        const Node* root;
+        size_t readers = 0;
+        std::vector<const Node*> retired;   // Replaced while building this epoch
+    };
+
+    std::atomic<size_t> retention;          // Epochs kept readable, at least one
+    mutable std::deque<Version> versions;   // Ascending epochs, front is the oldest retained
+    mutable std::mutex versions_mutex;      // Version list and pin counts only
+    std::mutex publish_mutex;
+    std::atomic<size_t> live_nodes{0};
+
+    static size_t slot_of(AccountId id, size_t level) {
+        return (id >> (32 - FANOUT_BITS * (level + 1))) & (FANOUT - 1);
+    }
+
+    static bool is_empty(const Node* node, size_t level) {
+        for (size_t i = 0; i < FANOUT; ++i) {
+            if (level == LEAF_LEVEL ? node->balance[i] != 0 : node->child[i] != nullptr) return false;
+        }
+        return true;
+    }
+
+    // Copy-on-write update of one account below node; returns the new subtree
+    const Node* assign(const Node* node, size_t level, AccountId id, uint64_t value,
+                       uint64_t epoch, std::vector<const Node*>& retired) {
+        Node* fresh;
+        if (node && node->born == epoch) {
+            fresh = const_cast<Node*>(node);        // Built by this publish, not yet visible
+        } else {
+            if (!node && value == 0) return nullptr;
+            fresh = node ? new Node(*node) : new Node(epoch);
+            fresh->born = epoch;
+            live_nodes.fetch_add(1, std::memory_order_relaxed);
+            if (node) retired.push_back(node);
+        }
+
+        size_t slot = slot_of(id, level);
+        if (level == LEAF_LEVEL) {
+            fresh->balance[slot] = value;
+        } else {
+            fresh->child[slot] = assign(fresh->child[slot], level + 1, id, value, epoch, retired);
+        }
+
+        if (is_empty(fresh, level)) {
+            destroy(fresh);
+            return nullptr;
+        }
+        return fresh;
+    }
+
+    void destroy(const Node* node) {
+        delete node;
+        live_nodes.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void destroy_tree(const Node* node, size_t level) {
+        if (!node) return;
+        if (level < LEAF_LEVEL) {
+            for (const Node* child : node->child) destroy_tree(child, level + 1);
+        }
+        destroy(node);
+    }
+
+    static uint64_t lookup(const Node* node, AccountId id) {
+        for (size_t level = 0; node; ++level) {
+            if (level == LEAF_LEVEL) return node->balance[slot_of(id, level)];
+            node = node->child[slot_of(id, level)];
+        }
+        return 0;
+    }
+
+    template <typename Fn>
+    static void visit(const Node* node, size_t level, AccountId prefix, Fn& fn) {
+        if (!node) return;
+        for (size_t i = 0; i < FANOUT; ++i) {
+            AccountId id = prefix | static_cast<AccountId>(i << (32 - FANOUT_BITS * (level + 1)));
+            if (level == LEAF_LEVEL) {
+                if (node->balance[i]) fn(id, node->balance[i]);
+            } else {
+                visit(node->child[i], level + 1, id, fn);
+            }
+        }
+    }
+
+    void unpin(uint64_t epoch) const {
+        std::lock_guard<std::mutex> lock(versions_mutex);
+        size_t index = epoch - versions.front().epoch;
+        versions[index].readers--;
+    }
+
+    // Drop expired, unpinned epochs from the front and free what only they reached
+    size_t reclaim() {
+        std::vector<const Node*> garbage;
+        {
+            std::lock_guard<std::mutex> lock(versions_mutex);
+            size_t keep = retention.load(std::memory_order_relaxed);
+            while (versions.size() > keep && versions.front().readers == 0) {
+                versions.pop_front();
+                // Nodes the new front replaced were reachable only from older epochs
+                garbage.swap(versions.front().retired);
+                for (const Node* node : garbage) destroy(node);
+                garbage.clear();
+            }
+        }
+        return live_nodes.load(std::memory_order_relaxed);
+    }
+
+public:
+    // A pinned, read-only view of one epoch
+    class Snapshot {
+    private:
+        const BalanceSnapshots* owner = nullptr;
+        const Node* root = nullptr;
+        uint64_t snapshot_epoch = 0;
+
+        friend class BalanceSnapshots;
+        Snapshot(const BalanceSnapshots* store, const Node* r, uint64_t epoch)
+            : owner(store), root(r), snapshot_epoch(epoch) {}
+
+    public:
+        Snapshot() = default;
+        Snapshot(Snapshot&& other) noexcept
+            : owner(other.owner), root(other.root), snapshot_epoch(other.snapshot_epoch) {
+            other.owner = nullptr;
+        }
+        Snapshot& operator=(Snapshot&& other) noexcept {
+            if (this != &other) {
+                release();
+                owner = other.owner;
+                root = other.root;
+                snapshot_epoch = other.snapshot_epoch;
+                other.owner = nullptr;
+            }
+            return *this;
+        }
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+        ~Snapshot() { release(); }
+
+        void release() {
+            if (owner) owner->unpin(snapshot_epoch);
+            owner = nullptr;
+            root = nullptr;
+        }
+
+        // False when the requested epoch was never published or already reclaimed
+        bool valid() const { return owner != nullptr; }
+        uint64_t epoch() const { return snapshot_epoch; }
+
+        uint64_t balanceOf(AccountId id) const {
+            return id == INVALID_ACCOUNT ? 0 : lookup(root, id);
+        }
+
+        // fn(AccountId, uint64_t) for every non-zero balance, in id order
+        template <typename Fn>
+        void for_each(Fn fn) const {
+            visit(root, 0, 0, fn);
+        }
+    };
+
+    explicit BalanceSnapshots(size_t retained_epochs = 256)
+        : retention(retained_epochs ? retained_epochs : 1) {
+        versions.push_back(Version{0, nullptr, 0, {}});
+    }
+
+    ~BalanceSnapshots() {
+        // Every node is reachable from the latest root or sits in exactly one retired list
+        for (size_t i = 1; i < versions.size(); ++i) {
+            for (const Node* node : versions[i].retired) destroy(node);
+        }
+        destroy_tree(versions.back().root, 0);
+    }
+
+    BalanceSnapshots(const BalanceSnapshots&) = delete;
+    BalanceSnapshots& operator=(const BalanceSnapshots&) = delete;
+
+    // Publish the next epoch; changes are (account, new balance) pairs
+    uint64_t publish(const std::vector<std::pair<AccountId, uint64_t>>& changes) {
+        std::lock_guard<std::mutex> serial(publish_mutex);
+        const Node* root;
+        uint64_t epoch;
+        {
+            std::lock_guard<std::mutex> lock(versions_mutex);
+            root = versions.back().root;
+            epoch = versions.back().epoch + 1;
+        }
+
+        std::vector<const Node*> retired;
+        for (const auto& change : changes) {
+            root = assign(root, 0, change.first, change.second, epoch, retired);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(versions_mutex);
+            versions.push_back(Version{epoch, root, 0, std::move(retired)});
+        }
+        reclaim();
+        return epoch;
+    }
+
+    Snapshot at_epoch(uint64_t epoch) const {
+        std::lock_guard<std::mutex> lock(versions_mutex);
+        if (epoch < versions.front().epoch || epoch > versions.back().epoch) return Snapshot();
+        Version& version = versions[epoch - versions.front().epoch];
+        version.readers++;
+        return Snapshot(this, version.root, epoch);
+    }
+
+    Snapshot latest() const {
+        std::lock_guard<std::mutex> lock(versions_mutex);
+        Version& version = versions.back();
+        version.readers++;
+        return Snapshot(this, version.root, version.epoch);
+    }
+
+    uint64_t latest_epoch() const {
+        std::lock_guard<std::mutex> lock(versions_mutex);
+        return versions.back().epoch;
+    }
+
+    uint64_t oldest_epoch() const {
+        std::lock_guard<std::mutex> lock(versions_mutex);
+        return versions.front().epoch;
+    }
+
+    // Shrinking frees the dropped epochs now, unless readers pin them
+    void set_retention(size_t retained_epochs) {
+        retention.store(retained_epochs ? retained_epochs : 1, std::memory_order_relaxed);
+        collect();
+    }
+    size_t retained() const { return retention.load(std::memory_order_relaxed); }
+
+    // Retry reclamation held back by readers that have since unpinned
+    size_t collect() {
+        std::lock_guard<std::mutex> serial(publish_mutex);
+        return reclaim();
+    }
+
+    size_t node_count() const { return live_nodes.load(std::memory_order_relaxed); }
+    size_t memory_bytes() const { return node_count() * sizeof(Node); }
+};
+
+} // namespace qOracle
+
+#endif // BALANCE_SNAPSHOTS_HPP
@@ -0,0 +1,521 @@
+/*
+ * Sharded Balance Table for qOracle Token Ledgers
+ * Dense balances indexed by AccountId with striped locking
+ *
+ * Balances live in fixed-size chunks that never move once allocated, so
+ * a slot can be read and written while other threads grow the table.
+ * The chunk directory is two-level and its pages are allocated on first
+ * use too, so an empty table costs a few KiB rather than a directory
+ * sized for every possible id.
+ * Accounts map onto NUM_SHARDS lock stripes by a hash of their id;
+ * operations on unrelated accounts therefore proceed in parallel, and
+ * two-account operations take both stripes in ascending shard order so
+ * they cannot deadlock against each other.
+ *
+ * In LockFree mode every balance sits on its own cache line and single
+ * transfers skip the stripes entirely: the debit is a compare-and-swap
+ * that refuses to go below zero, followed by an atomic credit. Each
+ * account is linearizable on its own; a concurrent observer summing all
+ * balances can see an amount "in flight" between the two steps, but the
+ * total is conserved once transfers quiesce. Multi-account operations
+ * still take stripes, and use the same atomic debit/credit so they stay
+ * correct alongside lock-free transfers.
+ *
+ * Reads and failed debits never allocate: an account only occupies
+ * memory once it has been credited. compact() hands back chunks whose
+ * balances have all returned to zero.
+ *
+ * With change tracking enabled every write also sets the account's bit
+ * in a per-chunk bitmap; drain_changes() collects and clears them so a
+ * state commitment can rehash only the accounts that moved.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef BALANCE_TABLE_HPP
+#define BALANCE_TABLE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "AddressRegistry.hpp"
+#include "FlatHashMap.hpp"
+#include "ProfiledMutex.hpp"
+
+namespace qOracle {
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+enum class LedgerMode : uint8_t {
+    Striped,    // Per-shard locks, densely packed balances
+    LockFree    // Cache-line padded atomic balances, CAS transfers
+};
+
+// Capacity-planning snapshot of one ledger
+struct LedgerStats {
+    size_t allocated_chunks = 0;
+    size_t live_accounts = 0;          // Accounts with a non-zero balance
+    size_t ledger_bytes = 0;           // Chunk storage plus chunk directory
+    size_t bytes_per_account = 0;      // ledger_bytes / live_accounts
+    size_t released_chunks = 0;        // Chunks freed by the last compaction
+};
+
+// Batch transfer inputs
+struct TransferLeg {
+    AccountId to;
+    uint64_t amount;
+};
+
+struct TransferOrder {
+    AccountId from;
+    AccountId to;
+    uint64_t amount;
+};
+
+enum class BatchMode : uint8_t {
+    AllOrNothing,   // Apply every order or none of them
+    BestEffort      // Apply orders in sequence, skipping the ones that fail
+};
+
+struct BatchResult {
+    size_t applied = 0;             // Orders applied
+    uint64_t volume = 0;            // Sum of applied amounts
+    std::vector<bool> status;       // Per-order outcome, in input order
+};
+
+class BalanceTable {
+public:
+    static constexpr size_t NUM_SHARDS = 64;
+
+private:
+    static constexpr size_t CHUNK_BITS = 14;
+    static constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS;       // 16384 accounts, 128 KiB packed
+    static constexpr size_t MAX_CHUNKS = (size_t(1) << 32) >> CHUNK_BITS;
+    static constexpr size_t PAGE_BITS = 9;
+    static constexpr size_t PAGE_SIZE = size_t(1) << PAGE_BITS;          // Chunk pointers per directory page
+    static constexpr size_t MAX_PAGES = MAX_CHUNKS / PAGE_SIZE;
+    static constexpr size_t DIRTY_WORDS = CHUNK_SIZE / 64;               // Change bitmap after the balances
+
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        ProfiledMutex mutex{"balances.stripe"};
+    };
+
+    using Balance = std::atomic<uint64_t>;
+    using DirtyWord = std::atomic<uint64_t>;
+    using ChunkSlot = std::atomic<char*>;
+
+    const LedgerMode ledger_mode;
+    const size_t stride;                 // Bytes between consecutive balances
+    const bool track_changes;
+    std::array<std::atomic<ChunkSlot*>, MAX_PAGES> directory{};
+    std::atomic<size_t> chunk_count{0};
+    std::atomic<size_t> page_count{0};
+    mutable std::array<Shard, NUM_SHARDS> shards;
+    mutable ProfiledMutex growth_mutex{"balances.growth"};   // Chunk allocation, release and scans
+
+    // Slot for chunk index, or nullptr if its directory page was never needed
+    ChunkSlot* slot(size_t index) const {
+        ChunkSlot* page = directory[index >> PAGE_BITS].load(std::memory_order_acquire);
+        return page ? page + (index & (PAGE_SIZE - 1)) : nullptr;
+    }
+
+    char* chunk_for(AccountId id) const {
+        ChunkSlot* s = slot(id >> CHUNK_BITS);
+        return s ? s->load(std::memory_order_acquire) : nullptr;
+    }
+
+    // fn(index, slot) for every slot on an allocated directory page
+    template <typename Fn>
+    void for_each_slot(Fn fn) const {
+        for (size_t p = 0; p < MAX_PAGES; ++p) {
+            ChunkSlot* page = directory[p].load(std::memory_order_acquire);
+            if (!page) continue;
+            for (size_t i = 0; i < PAGE_SIZE; ++i) fn((p << PAGE_BITS) + i, page[i]);
+        }
+    }
+
+    size_t directory_bytes() const {
+        return sizeof(directory) + page_count.load(std::memory_order_relaxed) * PAGE_SIZE * sizeof(ChunkSlot);
+    }
+
+    size_t chunk_bytes() const { return CHUNK_SIZE * stride + DIRTY_WORDS * sizeof(DirtyWord); }
+
+    DirtyWord* dirty_words(char* chunk) const {
+        return reinterpret_cast<DirtyWord*>(chunk + CHUNK_SIZE * stride);
+    }
+
+    void mark_changed(char* chunk, AccountId id) {
+        if (!track_changes) return;
+        size_t slot = id & (CHUNK_SIZE - 1);
+        dirty_words(chunk)[slot / 64].fetch_or(uint64_t(1) << (slot % 64), std::memory_order_release);
+    }
+
+    bool chunk_has_changes(char* chunk) const {
+        for (size_t w = 0; w < DIRTY_WORDS; ++w) {
+            if (dirty_words(chunk)[w].load(std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+
+    char* allocate_chunk(size_t index) {
+        std::lock_guard<ProfiledMutex> lock(growth_mutex);
+        ChunkSlot* page = directory[index >> PAGE_BITS].load(std::memory_order_relaxed);
+        if (!page) {
+            page = new ChunkSlot[PAGE_SIZE]();
+            directory[index >> PAGE_BITS].store(page, std::memory_order_release);
+            page_count.fetch_add(1, std::memory_order_relaxed);
+        }
+        ChunkSlot& s = page[index & (PAGE_SIZE - 1)];
+        char* chunk = s.load(std::memory_order_relaxed);
+        if (!chunk) {
+            chunk = static_cast<char*>(::operator new(chunk_bytes(), std::align_val_t(CACHE_LINE_SIZE)));
+            for (size_t i = 0; i < CHUNK_SIZE; ++i) {
+                new (chunk + i * stride) Balance(0);
+            }
+            for (size_t w = 0; w < DIRTY_WORDS; ++w) {
+                new (dirty_words(chunk) + w) DirtyWord(0);
+            }
+            s.store(chunk, std::memory_order_release);
+            chunk_count.fetch_add(1, std::memory_order_relaxed);
+        }
+        return chunk;
+    }
+
+    static Balance& at(char* chunk, size_t stride, AccountId id) {
+        return *reinterpret_cast<Balance*>(chunk + (id & (CHUNK_SIZE - 1)) * stride);
+    }
+
+    // Atomic debit that never underflows
+    static bool debit_cell(Balance& cell, uint64_t amount) {
+        uint64_t current = cell.load(std::memory_order_relaxed);
+        do {
+            if (current < amount) return false;
+        } while (!cell.compare_exchange_weak(current, current - amount,
+                                             std::memory_order_acq_rel, std::memory_order_relaxed));
+        return true;
+    }
+
+    bool chunk_is_zero(char* chunk) const {
+        for (size_t i = 0; i < CHUNK_SIZE; ++i) {
+            if (reinterpret_cast<Balance*>(chunk + i * stride)->load(std::memory_order_relaxed)) return false;
+        }
+        return true;
+    }
+
+    void fill_stats(LedgerStats& stats) const {
+        for_each_slot([&](size_t, const ChunkSlot& s) {
+            char* chunk = s.load(std::memory_order_acquire);
+            if (!chunk) return;
+            stats.allocated_chunks++;
+            for (size_t i = 0; i < CHUNK_SIZE; ++i) {
+                if (reinterpret_cast<Balance*>(chunk + i * stride)->load(std::memory_order_relaxed)) {
+                    stats.live_accounts++;
+                }
+            }
+        });
+        stats.ledger_bytes = stats.allocated_chunks * chunk_bytes() + directory_bytes();
+        stats.bytes_per_account = stats.live_accounts ? stats.ledger_bytes / stats.live_accounts : 0;
+    }
+
+public:
+    using ShardLock = std::unique_lock<ProfiledMutex>;
+
+    // Locks held for a two-account operation (one lock if both share a shard)
+    struct PairLock {
+        ShardLock first;
+        ShardLock second;
+    };
+
+    explicit BalanceTable(LedgerMode mode = LedgerMode::Striped, bool track = false)
+        : ledger_mode(mode),
+          stride(mode == LedgerMode::LockFree ? CACHE_LINE_SIZE : sizeof(Balance)),
+          track_changes(track) {}
+
+    ~BalanceTable() {
+        for (auto& entry : directory) {
+            ChunkSlot* page = entry.load(std::memory_order_relaxed);
+            if (!page) continue;
+            for (size_t i = 0; i < PAGE_SIZE; ++i) {
+                char* chunk = page[i].load(std::memory_order_relaxed);
+                if (chunk) ::operator delete(chunk, std::align_val_t(CACHE_LINE_SIZE));
+            }
+            delete[] page;
+        }
+    }
+
+    BalanceTable(const BalanceTable&) = delete;
+    BalanceTable& operator=(const BalanceTable&) = delete;
+
+    static size_t shard_of(AccountId id) {
+        uint32_t h = id * 0x9E3779B1u;             // Fibonacci hashing spreads dense ids
+        return h >> (32 - 6);
+    }
+    static_assert(NUM_SHARDS == 64, "shard_of assumes 64 shards");
+
+    ShardLock lock(AccountId id) const {
+        return ShardLock(shards[shard_of(id)].mutex);
+    }
+
+    PairLock lock_pair(AccountId a, AccountId b) const {
+        size_t sa = shard_of(a);
+        size_t sb = shard_of(b);
+        if (sa == sb) return PairLock{ShardLock(shards[sa].mutex), ShardLock()};
+        if (sa > sb) std::swap(sa, sb);
+        ShardLock first(shards[sa].mutex);
+        ShardLock second(shards[sb].mutex);
+        return PairLock{std::move(first), std::move(second)};
+    }
+
+    LedgerMode mode() const { return ledger_mode; }
+
+    // Read without taking a stripe
+    uint64_t load(AccountId id) const {
+        if (id == INVALID_ACCOUNT) return 0;
+        char* chunk = chunk_for(id);
+        return chunk ? at(chunk, stride, id).load(std::memory_order_acquire) : 0;
+    }
+
+    static uint64_t shard_bit(AccountId id) { return uint64_t(1) << shard_of(id); }
+
+    // Lock every shard in mask, in ascending shard order
+    std::vector<ShardLock> lock_shards(uint64_t mask) const {
+        std::vector<ShardLock> held;
+        held.reserve(__builtin_popcountll(mask));
+        for (; mask; mask &= mask - 1) {
+            held.emplace_back(shards[__builtin_ctzll(mask)].mutex);
+        }
+        return held;
+    }
+
+    // Stripe-free primitives; callers that need multi-account atomicity
+    // hold the relevant stripes around them
+    bool debit_unlocked(AccountId id, uint64_t amount) {
+        if (id == INVALID_ACCOUNT) return amount == 0;
+        char* chunk = chunk_for(id);
+        if (!chunk) return amount == 0;
+        if (!debit_cell(at(chunk, stride, id), amount)) return false;
+        mark_changed(chunk, id);
+        return true;
+    }
+
+    void store_unlocked(AccountId id, uint64_t value) {
+        char* chunk = chunk_for(id);
+        if (!chunk) {
+            if (value == 0) return;
+            chunk = allocate_chunk(id >> CHUNK_BITS);
+        }
+        at(chunk, stride, id).store(value, std::memory_order_release);
+        mark_changed(chunk, id);
+    }
+
+    void credit_unlocked(AccountId id, uint64_t amount) {
+        char* chunk = chunk_for(id);
+        if (!chunk) chunk = allocate_chunk(id >> CHUNK_BITS);
+        at(chunk, stride, id).fetch_add(amount, std::memory_order_acq_rel);
+        mark_changed(chunk, id);
+    }
+
+    uint64_t get(AccountId id) const {
+        if (id == INVALID_ACCOUNT) return 0;
+        if (ledger_mode == LedgerMode::LockFree) return load(id);
+        auto guard = lock(id);
+        return load(id);
+    }
+
+    void credit(AccountId id, uint64_t amount) {
+        if (ledger_mode == LedgerMode::LockFree) return credit_unlocked(id, amount);
+        auto guard = lock(id);
+        credit_unlocked(id, amount);
+    }
+
+    bool debit(AccountId id, uint64_t amount) {
+        if (ledger_mode == LedgerMode::LockFree) return debit_unlocked(id, amount);
+        auto guard = lock(id);
+        return debit_unlocked(id, amount);
+    }
+
+    bool transfer(AccountId from, AccountId to, uint64_t amount) {
+        if (ledger_mode == LedgerMode::LockFree) {
+            if (!debit_unlocked(from, amount)) return false;
+            credit_unlocked(to, amount);
+            return true;
+        }
+        auto guard = lock_pair(from, to);
+        if (!debit_unlocked(from, amount)) return false;
+        credit_unlocked(to, amount);
+        return true;
+    }
+
+    // Apply a batch under one acquisition of every shard it touches.
+    // AllOrNothing replays the orders against a private view first, so an
+    // order may spend funds credited earlier in the same batch; the net
+    // per-account deltas are then applied debits-first, which lets the
+    // batch back out cleanly if a lock-free transfer drained a sender.
+    BatchResult apply_batch(const std::vector<TransferOrder>& orders, BatchMode mode) {
+        BatchResult result;
+        result.status.assign(orders.size(), false);
+
+        uint64_t mask = 0;
+        for (const auto& order : orders) {
+            if (order.from != INVALID_ACCOUNT) mask |= shard_bit(order.from);
+            if (order.to != INVALID_ACCOUNT) mask |= shard_bit(order.to);
+        }
+        auto guard = lock_shards(mask);
+
+        if (mode == BatchMode::BestEffort) {
+            for (size_t i = 0; i < orders.size(); ++i) {
+                const auto& order = orders[i];
+                if (order.amount == 0 || order.to == INVALID_ACCOUNT) continue;
+                if (!debit_unlocked(order.from, order.amount)) continue;
+                credit_unlocked(order.to, order.amount);
+                result.status[i] = true;
+                result.applied++;
+                result.volume += order.amount;
+            }
+            return result;
+        }
+
+        struct Delta {
+            uint64_t balance;
+            uint64_t debited;
+            uint64_t credited;
+        };
+        FlatHashMap<AccountId, Delta> view(orders.size() * 2);
+        auto touch = [&](AccountId id) -> Delta& {
+            auto it = view.find(id);
+            if (it != view.end()) return it->second;
+            return view.emplace(id, Delta{load(id), 0, 0}).first->second;
+        };
+
+        uint64_t volume = 0;
+        for (const auto& order : orders) {
+            if (order.amount == 0 || order.from == INVALID_ACCOUNT || order.to == INVALID_ACCOUNT) return result;
+            Delta& from = touch(order.from);
+            if (from.balance < order.amount) return result;
+            from.balance -= order.amount;
+            from.debited += order.amount;
+
+            Delta& to = touch(order.to);
+            to.balance += order.amount;
+            to.credited += order.amount;
+            volume += order.amount;
+        }
+
+        std::vector<std::pair<AccountId, uint64_t>> debited;
+        for (const auto& entry : view) {
+            const Delta& d = entry.second;
+            if (d.debited <= d.credited) continue;
+            if (!debit_unlocked(entry.first, d.debited - d.credited)) {
+                for (const auto& undo : debited) credit_unlocked(undo.first, undo.second);
+                return result;
+            }
+            debited.emplace_back(entry.first, d.debited - d.credited);
+        }
+        for (const auto& entry : view) {
+            const Delta& d = entry.second;
+            if (d.credited > d.debited) credit_unlocked(entry.first, d.credited - d.debited);
+        }
+
+        result.status.assign(orders.size(), true);
+        result.applied = orders.size();
+        result.volume = volume;
+        return result;
+    }
+
+    // Collect (account, balance) for every account written since the last
+    // drain. Callers wanting a consistent cut hold every stripe around it.
+    void drain_changes(std::vector<std::pair<AccountId, uint64_t>>& out) {
+        if (!track_changes) return;
+        std::lock_guard<ProfiledMutex> growth(growth_mutex);
+        for_each_slot([&](size_t c, ChunkSlot& s) {
+            char* chunk = s.load(std::memory_order_acquire);
+            if (!chunk) return;
+            for (size_t w = 0; w < DIRTY_WORDS; ++w) {
+                uint64_t bits = dirty_words(chunk)[w].exchange(0, std::memory_order_acquire);
+                for (; bits; bits &= bits - 1) {
+                    AccountId id = static_cast<AccountId>((c << CHUNK_BITS) + w * 64 + __builtin_ctzll(bits));
+                    out.emplace_back(id, at(chunk, stride, id).load(std::memory_order_acquire));
+                }
+            }
+        });
+    }
+
+    // Free chunks whose balances are all zero. Lock-free readers touch
+    // chunks without stripes, so LockFree tables only report statistics.
+    // Chunks with undrained changes stay until their commitment catches up.
+    LedgerStats compact() {
+        LedgerStats stats;
+        if (ledger_mode == LedgerMode::Striped) {
+            auto guard = lock_shards(~uint64_t(0));
+            std::lock_guard<ProfiledMutex> growth(growth_mutex);
+            for_each_slot([&](size_t, ChunkSlot& s) {
+                char* chunk = s.load(std::memory_order_relaxed);
+                if (!chunk || !chunk_is_zero(chunk) || chunk_has_changes(chunk)) return;
+                s.store(nullptr, std::memory_order_release);
+                ::operator delete(chunk, std::align_val_t(CACHE_LINE_SIZE));
+                chunk_count.fetch_sub(1, std::memory_order_relaxed);
+                stats.released_chunks++;
+            });
+        }
+        std::lock_guard<ProfiledMutex> growth(growth_mutex);
+        fill_stats(stats);
+        return stats;
+    }
+
+    // Approximate under concurrent writes
+    LedgerStats stats() const {
+        LedgerStats stats;
+        std::lock_guard<ProfiledMutex> growth(growth_mutex);
+        fill_stats(stats);
+        return stats;
+    }
+
+    size_t allocated_chunks() const { return chunk_count.load(std::memory_order_relaxed); }
+    size_t bytes_per_account() const { return stride; }
+    size_t memory_bytes() const {
+        return allocated_chunks() * chunk_bytes() + directory_bytes();
+    }
+};
+
+class ShardedCounter;
+
+// One token ledger as seen by multi-ledger writers (block executor, transactions)
+struct BlockLedger {
+    BalanceTable* balances;
+    ShardedCounter* supply;            // nullptr for fixed-supply tokens
+};
+
+// Stripes to take in one table as part of a multi-ledger operation
+struct StripeRequest {
+    BalanceTable* table;
+    uint64_t shard_mask;
+};
+
+// Lock stripes across several tables in the global order: tables by
+// address, then shards ascending. Every multi-ledger writer goes through
+// here so they cannot deadlock against each other.
+inline std::vector<std::vector<BalanceTable::ShardLock>> lock_stripes(std::vector<StripeRequest> requests) {
+    std::sort(requests.begin(), requests.end(), [](const StripeRequest& a, const StripeRequest& b) {
+        return std::less<BalanceTable*>()(a.table, b.table);
+    });
+    std::vector<std::vector<BalanceTable::ShardLock>> held;
+    for (size_t i = 0; i < requests.size(); ++i) {
+        uint64_t mask = requests[i].shard_mask;
+        while (i + 1 < requests.size() && requests[i + 1].table == requests[i].table) {
+            mask |= requests[++i].shard_mask;
+        }
+        held.push_back(requests[i].table->lock_shards(mask));
+    }
+    return held;
+}
+
+} // namespace qOracle
+
+#endif // BALANCE_TABLE_HPP
@@ -0,0 +1,329 @@
+/*
+ * Optimistic Parallel Block Executor for qOracle Token Ledgers
+ * Block-STM style speculative execution over multi-version balances
+ *
+ * Transactions of a block run speculatively on a worker pool. Every
+ * balance a transaction reads is resolved against a multi-version store
+ * holding the writes of lower-indexed transactions, and the version it
+ * saw is recorded. After each wave the read sets are validated; only
+ * transactions whose reads went stale are executed again. The lowest
+ * invalid transaction always validates after its next execution, so the
+ * loop terminates, and the committed state is exactly the state a
+ * serial run in block order would produce.
+ *
+ * A wave can fix as little as one transaction, so a chain of dependent
+ * transactions (one hot sender paying many recipients) would take as
+ * many waves as it has links, each validating the whole suffix. After
+ * max_waves waves the executor stops speculating and runs the remaining
+ * suffix once, serially, in block order.
+ *
+ * The executor holds the stripes of every account the block touches
+ * for the whole run. Ledgers in LockFree mode let single transfers
+ * bypass those stripes, so callers must quiesce them during a block.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef BLOCK_EXECUTOR_HPP
+#define BLOCK_EXECUTOR_HPP
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#include "AddressRegistry.hpp"
+#include "BalanceTable.hpp"
+#include "ShardedCounter.hpp"
+#include "FlatHashMap.hpp"
+#include "WorkerPool.hpp"
+
+namespace qOracle {
+
+enum class TxKind : uint8_t { Transfer, Mint, Burn };
+
+struct BlockTx {
+    uint8_t token;          // Index into the ledgers passed to execute()
+    TxKind kind;
+    AccountId sender;       // Authorizing account
+    AccountId from;         // Debited account (Transfer, Burn)
+    AccountId to;           // Credited account (Transfer, Mint)
+    uint64_t amount;
+};
+
+struct BlockResult {
+    std::vector<bool> success;         // Per transaction, in block order
+    size_t executions = 0;             // Including re-executions
+    size_t waves = 0;                  // Parallel waves
+    size_t serial_executions = 0;      // Suffix run in order after max_waves
+};
+
+class BlockExecutor {
+private:
+    static constexpr int64_t BASE_VERSION = -1;
+    static constexpr size_t DEFAULT_MAX_WAVES = 4;
+
+    struct WriteSlot {
+        uint32_t incarnation = 0;
+        bool written = false;
+        uint64_t value = 0;
+    };
+
+    // All transactions that may write one (token, account) balance
+    struct KeyVersions {
+        uint8_t token;
+        AccountId account;
+        uint64_t base;                       // Committed value before the block
+        std::vector<uint32_t> writers;       // Transaction indices, ascending
+        std::vector<WriteSlot> slots;        // Parallel to writers
+        std::mutex key_mutex;
+    };
+
+    struct ReadRecord {
+        uint32_t key;
+        int64_t writer;                      // BASE_VERSION or transaction index
+        uint32_t incarnation;
+    };
+
+    struct TxState {
+        uint32_t keys[2];                    // Static write set (debit key, credit key)
+        uint8_t key_count = 0;
+        uint32_t incarnation = 0;
+        bool success = false;
+        std::vector<ReadRecord> reads;
+    };
+
+    WorkerPool pool;
+    const size_t max_waves;                  // Parallel waves before the serial fallback
+
+    static uint64_t key_of(uint8_t token, AccountId account) {
+        return (static_cast<uint64_t>(token) << 32) | account;
+    }
+
+    // Latest version of key visible to transaction tx; caller holds key_mutex
+    static void latest_before(const KeyVersions& kv, uint32_t tx, int64_t& writer,
+                              uint32_t& incarnation, uint64_t& value) {
+        auto it = std::lower_bound(kv.writers.begin(), kv.writers.end(), tx);
+        for (size_t i = it - kv.writers.begin(); i-- > 0;) {
+            if (kv.slots[i].written) {
+                writer = kv.writers[i];
+                incarnation = kv.slots[i].incarnation;
+                value = kv.slots[i].value;
+                return;
+            }
+        }
+        writer = BASE_VERSION;
+        incarnation = 0;
+        value = kv.base;
+    }
+
+    static size_t slot_index(const KeyVersions& kv, uint32_t tx) {
+        return std::lower_bound(kv.writers.begin(), kv.writers.end(), tx) - kv.writers.begin();
+    }
+
+    static void execute_tx(const BlockTx& tx, uint32_t index, TxState& state,
+                           std::vector<std::unique_ptr<KeyVersions>>& keys) {
+        struct LocalWrite { uint32_t key; uint64_t value; };
+        LocalWrite writes[2];
+        size_t write_count = 0;
+        state.reads.clear();
+
+        auto read = [&](uint32_t key) -> uint64_t {
+            for (size_t i = 0; i < write_count; ++i) {
+                if (writes[i].key == key) return writes[i].value;
+            }
+            KeyVersions& kv = *keys[key];
+            int64_t writer;
+            uint32_t incarnation;
+            uint64_t value;
+            {
+                std::lock_guard<std::mutex> lock(kv.key_mutex);
+                latest_before(kv, index, writer, incarnation, value);
+            }
+            state.reads.push_back({key, writer, incarnation});
+            return value;
+        };
+        auto write = [&](uint32_t key, uint64_t value) {
+            for (size_t i = 0; i < write_count; ++i) {
+                if (writes[i].key == key) { writes[i].value = value; return; }
+            }
+            writes[write_count++] = {key, value};
+        };
+
+        bool ok = tx.amount > 0;
+        if (ok && tx.kind != TxKind::Mint) {
+            uint64_t balance = read(state.keys[0]);
+            ok = balance >= tx.amount;
+            if (ok) write(state.keys[0], balance - tx.amount);
+        }
+        if (ok && tx.kind != TxKind::Burn) {
+            uint32_t credit_key = state.keys[state.key_count - 1];
+            write(credit_key, read(credit_key) + tx.amount);
+        }
+        state.success = ok;
+
+        // Publish this incarnation's writes, clearing any left by the previous one
+        for (uint8_t k = 0; k < state.key_count; ++k) {
+            uint32_t key = state.keys[k];
+            if (k == 1 && key == state.keys[0]) break;
+            KeyVersions& kv = *keys[key];
+            std::lock_guard<std::mutex> lock(kv.key_mutex);
+            WriteSlot& slot = kv.slots[slot_index(kv, index)];
+            slot.incarnation = state.incarnation;
+            slot.written = false;
+            for (size_t i = 0; i < write_count; ++i) {
+                if (ok && writes[i].key == key) {
+                    slot.written = true;
+                    slot.value = writes[i].value;
+                }
+            }
+        }
+    }
+
+    static bool validate_tx(uint32_t index, const TxState& state,
+                            std::vector<std::unique_ptr<KeyVersions>>& keys) {
+        for (const auto& r : state.reads) {
+            KeyVersions& kv = *keys[r.key];
+            int64_t writer;
+            uint32_t incarnation;
+            uint64_t value;
+            std::lock_guard<std::mutex> lock(kv.key_mutex);
+            latest_before(kv, index, writer, incarnation, value);
+            if (writer != r.writer || incarnation != r.incarnation) return false;
+        }
+        return true;
+    }
+
+public:
+    explicit BlockExecutor(size_t threads = std::max(1u, std::thread::hardware_concurrency()),
+                           size_t waves = DEFAULT_MAX_WAVES)
+        : pool(threads), max_waves(std::max<size_t>(1, waves)) {}
+
+    size_t threads() const { return pool.size(); }
+    WorkerPool& workers() { return pool; }
+
+    // Execute txs in block order semantics. Transactions with
+    // authorized[i] == false fail without touching state. Ledgers in
+    // LockFree mode must have no concurrent single transfers.
+    BlockResult execute(const std::vector<BlockTx>& txs, const std::vector<BlockLedger>& ledgers,
+                        const std::vector<bool>& authorized) {
+        BlockResult result;
+        result.success.assign(txs.size(), false);
+        if (txs.empty()) return result;
+
+        // Build the static key set of every transaction
+        FlatHashMap<uint64_t, uint32_t> key_index(txs.size() * 2);
+        std::vector<std::unique_ptr<KeyVersions>> keys;
+        std::vector<TxState> states(txs.size());
+        std::vector<uint64_t> shard_masks(ledgers.size(), 0);
+
+        auto key_for = [&](uint8_t token, AccountId account) -> uint32_t {
+            uint64_t k = key_of(token, account);
+            auto it = key_index.find(k);
+            if (it != key_index.end()) return it->second;
+            uint32_t id = static_cast<uint32_t>(keys.size());
+            key_index.emplace(k, id);
+            keys.emplace_back(new KeyVersions());
+            keys.back()->token = token;
+            keys.back()->account = account;
+            shard_masks[token] |= BalanceTable::shard_bit(account);
+            return id;
+        };
+
+        std::vector<uint32_t> runnable;
+        for (uint32_t i = 0; i < txs.size(); ++i) {
+            const BlockTx& tx = txs[i];
+            if (!authorized[i] || tx.token >= ledgers.size()) continue;
+            bool needs_from = tx.kind != TxKind::Mint;
+            bool needs_to = tx.kind != TxKind::Burn;
+            if ((needs_from && tx.from == INVALID_ACCOUNT) || (needs_to && tx.to == INVALID_ACCOUNT)) continue;
+
+            TxState& state = states[i];
+            if (needs_from) state.keys[state.key_count++] = key_for(tx.token, tx.from);
+            if (needs_to) state.keys[state.key_count++] = key_for(tx.token, tx.to);
+            for (uint8_t k = 0; k < state.key_count; ++k) {
+                KeyVersions& kv = *keys[state.keys[k]];
+                if (kv.writers.empty() || kv.writers.back() != i) kv.writers.push_back(i);
+            }
+            runnable.push_back(i);
+        }
+
+        // Hold every touched stripe so the base state cannot move underneath us
+        std::vector<StripeRequest> stripes;
+        for (size_t t = 0; t < ledgers.size(); ++t) {
+            if (shard_masks[t]) stripes.push_back({ledgers[t].balances, shard_masks[t]});
+        }
+        auto guards = lock_stripes(std::move(stripes));
+        for (auto& kv : keys) {
+            kv->base = ledgers[kv->token].balances->load(kv->account);
+            kv->slots.resize(kv->writers.size());
+        }
+
+        // Speculate, validate, re-execute the invalid suffix
+        std::vector<uint32_t> pending = runnable;
+        std::vector<uint8_t> invalid(txs.size(), 0);
+        while (!pending.empty() && result.waves < max_waves) {
+            ++result.waves;
+            result.executions += pending.size();
+            pool.parallel_for(pending.size(), [&](size_t n) {
+                uint32_t i = pending[n];
+                execute_tx(txs[i], i, states[i], keys);
+            });
+
+            auto first = std::lower_bound(runnable.begin(), runnable.end(), pending.front());
+            std::vector<uint32_t> to_check(first, runnable.end());
+            pool.parallel_for(to_check.size(), [&](size_t n) {
+                uint32_t i = to_check[n];
+                invalid[i] = validate_tx(i, states[i], keys) ? 0 : 1;
+            });
+
+            pending.clear();
+            for (uint32_t i : to_check) {
+                if (invalid[i]) {
+                    states[i].incarnation++;
+                    pending.push_back(i);
+                }
+            }
+        }
+
+        // Everything below the lowest invalid transaction is final, so one
+        // in-order pass over the rest reads only final versions
+        if (!pending.empty()) {
+            for (auto it = std::lower_bound(runnable.begin(), runnable.end(), pending.front());
+                 it != runnable.end(); ++it) {
+                states[*it].incarnation++;
+                execute_tx(txs[*it], *it, states[*it], keys);
+                ++result.serial_executions;
+            }
+            result.executions += result.serial_executions;
+        }
+
+        // Commit the final version of every key and the supply deltas
+        for (auto& kv : keys) {
+            int64_t writer;
+            uint32_t incarnation;
+            uint64_t value;
+            latest_before(*kv, static_cast<uint32_t>(txs.size()), writer, incarnation, value);
+            if (writer != BASE_VERSION) {
+                ledgers[kv->token].balances->store_unlocked(kv->account, value);
+            }
+        }
+        for (uint32_t i : runnable) {
+            result.success[i] = states[i].success;
+            if (!states[i].success) continue;
+            ShardedCounter* supply = ledgers[txs[i].token].supply;
+            if (!supply) continue;
+            if (txs[i].kind == TxKind::Mint) supply->add(txs[i].amount);
+            if (txs[i].kind == TxKind::Burn) supply->sub(txs[i].amount);
+        }
+        return result;
+    }
+};
+
+} // namespace qOracle
+
+#endif // BLOCK_EXECUTOR_HPP
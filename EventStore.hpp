@@ -0,0 +1,381 @@
+/*
+ * Indexed Event Store for qOracle
+ * Append-only event log for QubicScan / indexer queries
+ *
+ * Events (Transfer, Mint, Burn, PriceUpdated, Swap, Proposal) are written
+ * as fixed-size records into append-only segment files. Secondary indexes
+ * by address, asset and time are rebuilt in memory on open, so queries such
+ * as "all transfers touching address X since T" only touch the matching
+ * postings instead of scanning the log.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef EVENT_STORE_HPP
+#define EVENT_STORE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <stdexcept>
+
+namespace qOracle {
+
+enum class EventType : uint8_t {
+    Transfer = 0,
+    Mint = 1,
+    Burn = 2,
+    PriceUpdated = 3,
+    Swap = 4,
+    Proposal = 5
+};
+
+constexpr uint32_t event_mask(EventType type) { return 1u << static_cast<uint32_t>(type); }
+constexpr uint32_t ALL_EVENTS = 0x3F;
+constexpr uint32_t NO_SYMBOL = std::numeric_limits<uint32_t>::max();
+
+// Transfer event sub-kind for aggregated batch records (aux = transfer count)
+constexpr uint8_t TRANSFER_BATCH = 1;
+
+// Swap event sub-kind for a queued request dropped at settlement (amount = request)
+constexpr uint8_t SWAP_REJECTED = 1;
+
+// Proposal event sub-kinds (stored in EventRecord::detail)
+enum class ProposalAction : uint8_t { Created = 0, Signed = 1, Executed = 2, Expired = 3 };
+
+// Fixed-size on-disk record; addresses and assets are dictionary ids
+struct EventRecord {
+    uint64_t sequence;      // Global, gap-free event number
+    uint64_t timestamp;     // Unix timestamp (non-decreasing in the log)
+    uint64_t amount;        // Token amount, price, or swap input
+    uint64_t aux;           // Swap output or proposal nonce
+    uint32_t from;          // Address id (NO_SYMBOL if not applicable)
+    uint32_t to;            // Address id (NO_SYMBOL if not applicable)
+    uint32_t asset;         // Asset id (NO_SYMBOL if not applicable)
+    EventType type;
+    uint8_t detail;         // Event specific sub-kind
+    uint16_t reserved;
+};
+static_assert(sizeof(EventRecord) == 48, "EventRecord layout is part of the segment format");
+
+// Query filter; empty strings mean "any"
+struct EventQuery {
+    std::string address;                                  // Matches from or to
+    std::string asset;
+    uint64_t since = 0;                                   // Inclusive
+    uint64_t until = std::numeric_limits<uint64_t>::max(); // Inclusive
+    uint32_t types = ALL_EVENTS;
+    size_t limit = std::numeric_limits<size_t>::max();
+};
+
+class EventStore {
+private:
+    static constexpr size_t SEGMENT_EVENTS = 1u << 20;   // 48 MiB per segment
+    static constexpr uint8_t SYMBOL_ADDRESS = 0;
+    static constexpr uint8_t SYMBOL_ASSET = 1;
+
+    struct Segment {
+        uint64_t first_sequence;
+        std::vector<EventRecord> events;
+    };
+
+    struct SymbolTable {
+        std::unordered_map<std::string, uint32_t> ids;
+        std::vector<std::string> names;
+        std::vector<std::vector<uint64_t>> postings;     // Sequences, ascending
+
+        uint32_t find(const std::string& name) const {
+            auto it = ids.find(name);
+            return it != ids.end() ? it->second : NO_SYMBOL;
+        }
+    };
+
+    std::filesystem::path directory;
+    std::vector<Segment> segments;
+    std::vector<uint64_t> segment_first_time;             // Time index, one entry per segment
+    SymbolTable addresses;
+    SymbolTable assets;
+    uint64_t next_sequence = 0;
+    uint64_t last_timestamp = 0;
+    std::ofstream segment_file;
+    std::ofstream symbol_file;
+    bool symbols_pending = false;                         // Buffered in symbol_file, not yet flushed
+    mutable std::shared_mutex store_mutex;
+
+public:
+    explicit EventStore(const std::string& dir) : directory(dir) {
+        std::filesystem::create_directories(directory);
+        load_symbols();
+        load_segments();
+        symbol_file.open(directory / "symbols.dat", std::ios::binary | std::ios::app);
+        open_segment_file();
+    }
+
+    ~EventStore() { flush(); }
+
+    EventStore(const EventStore&) = delete;
+    EventStore& operator=(const EventStore&) = delete;
+
+    // Append one event; returns its sequence number
+    uint64_t append(EventType type, uint64_t timestamp, const std::string& asset,
+                    const std::string& from, const std::string& to,
+                    uint64_t amount, uint64_t aux = 0, uint8_t detail = 0) {
+        std::unique_lock<std::shared_mutex> lock(store_mutex);
+
+        EventRecord record{};
+        record.sequence = next_sequence;
+        record.timestamp = std::max(timestamp, last_timestamp);
+        record.amount = amount;
+        record.aux = aux;
+        record.asset = asset.empty() ? NO_SYMBOL : intern(assets, SYMBOL_ASSET, asset);
+        record.from = from.empty() ? NO_SYMBOL : intern(addresses, SYMBOL_ADDRESS, from);
+        record.to = to.empty() ? NO_SYMBOL : intern(addresses, SYMBOL_ADDRESS, to);
+        record.type = type;
+        record.detail = detail;
+
+        // A record must never reach disk ahead of the symbols it names
+        if (symbols_pending) {
+            symbol_file.flush();
+            symbols_pending = false;
+        }
+        if (segments.empty() || segments.back().events.size() >= SEGMENT_EVENTS) {
+            start_segment(record);
+        }
+        segment_file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        index(record);
+        segments.back().events.push_back(record);
+
+        last_timestamp = record.timestamp;
+        return next_sequence++;
+    }
+
+    // Indexed query; results are in log order, capped at query.limit
+    std::vector<EventRecord> query(const EventQuery& q) const {
+        std::shared_lock<std::shared_mutex> lock(store_mutex);
+        std::vector<EventRecord> results;
+
+        uint32_t address_id = NO_SYMBOL;
+        uint32_t asset_id = NO_SYMBOL;
+        if (!q.address.empty() && (address_id = addresses.find(q.address)) == NO_SYMBOL) return results;
+        if (!q.asset.empty() && (asset_id = assets.find(q.asset)) == NO_SYMBOL) return results;
+
+        uint64_t first = sequence_at_or_after(q.since);
+        if (first >= next_sequence || q.limit == 0) return results;
+
+        auto accept = [&](const EventRecord& r) {
+            if (r.timestamp > q.until) return false;
+            if (!(q.types & event_mask(r.type))) return false;
+            if (asset_id != NO_SYMBOL && r.asset != asset_id) return false;
+            if (address_id != NO_SYMBOL && r.from != address_id && r.to != address_id) return false;
+            return true;
+        };
+
+        // Drive the scan from the most selective index available
+        const std::vector<uint64_t>* postings = nullptr;
+        if (address_id != NO_SYMBOL) postings = &addresses.postings[address_id];
+        if (asset_id != NO_SYMBOL && (!postings || assets.postings[asset_id].size() < postings->size())) {
+            postings = &assets.postings[asset_id];
+        }
+
+        if (postings) {
+            for (auto it = std::lower_bound(postings->begin(), postings->end(), first);
+                 it != postings->end() && results.size() < q.limit; ++it) {
+                const EventRecord& r = record_at(*it);
+                if (r.timestamp > q.until) break;
+                if (accept(r)) results.push_back(r);
+            }
+        } else {
+            for (uint64_t seq = first; seq < next_sequence && results.size() < q.limit; ++seq) {
+                const EventRecord& r = record_at(seq);
+                if (r.timestamp > q.until) break;
+                if (accept(r)) results.push_back(r);
+            }
+        }
+        return results;
+    }
+
+    // Human-readable rendering for explorers
+    std::string describe(const EventRecord& r) const {
+        static const char* TYPE_NAMES[] = {"Transfer", "Mint", "Burn", "PriceUpdated", "Swap", "Proposal"};
+        std::shared_lock<std::shared_mutex> lock(store_mutex);
+
+        std::ostringstream oss;
+        oss << "#" << r.sequence << " " << r.timestamp << " " << TYPE_NAMES[static_cast<uint8_t>(r.type)];
+        if (r.type == EventType::Swap && r.detail == SWAP_REJECTED) oss << " rejected";
+        if (r.asset != NO_SYMBOL) oss << " " << assets.names[r.asset];
+        if (r.from != NO_SYMBOL) oss << " from " << addresses.names[r.from];
+        if (r.to != NO_SYMBOL) oss << " to " << addresses.names[r.to];
+        oss << " amount " << r.amount;
+        if (r.aux) oss << " aux " << r.aux;
+        return oss.str();
+    }
+
+    std::string address_of(uint32_t id) const {
+        std::shared_lock<std::shared_mutex> lock(store_mutex);
+        return id < addresses.names.size() ? addresses.names[id] : std::string();
+    }
+
+    std::string asset_of(uint32_t id) const {
+        std::shared_lock<std::shared_mutex> lock(store_mutex);
+        return id < assets.names.size() ? assets.names[id] : std::string();
+    }
+
+    void flush() {
+        std::unique_lock<std::shared_mutex> lock(store_mutex);
+        segment_file.flush();
+        symbol_file.flush();
+    }
+
+    uint64_t size() const {
+        std::shared_lock<std::shared_mutex> lock(store_mutex);
+        return next_sequence;
+    }
+
+    size_t segment_count() const {
+        std::shared_lock<std::shared_mutex> lock(store_mutex);
+        return segments.size();
+    }
+
+private:
+    const EventRecord& record_at(uint64_t sequence) const {
+        return segments[sequence / SEGMENT_EVENTS].events[sequence % SEGMENT_EVENTS];
+    }
+
+    // First sequence whose timestamp >= t (timestamps are non-decreasing)
+    uint64_t sequence_at_or_after(uint64_t t) const {
+        if (segments.empty()) return next_sequence;
+        // Start in the last segment that begins before t: events at t may
+        // end that segment and continue into the next
+        auto seg_it = std::lower_bound(segment_first_time.begin(), segment_first_time.end(), t);
+        size_t seg = seg_it == segment_first_time.begin() ? 0 : (seg_it - segment_first_time.begin()) - 1;
+
+        for (; seg < segments.size(); ++seg) {
+            const auto& events = segments[seg].events;
+            auto it = std::lower_bound(events.begin(), events.end(), t,
+                [](const EventRecord& r, uint64_t value) { return r.timestamp < value; });
+            if (it != events.end()) return it->sequence;
+        }
+        return next_sequence;
+    }
+
+    uint32_t intern(SymbolTable& table, uint8_t kind, const std::string& name) {
+        auto it = table.ids.find(name);
+        if (it != table.ids.end()) return it->second;
+
+        uint32_t id = static_cast<uint32_t>(table.names.size());
+        table.ids.emplace(name, id);
+        table.names.push_back(name);
+        table.postings.emplace_back();
+
+        uint32_t len = static_cast<uint32_t>(name.size());
+        symbol_file.put(static_cast<char>(kind));
+        symbol_file.write(reinterpret_cast<const char*>(&len), sizeof(len));
+        symbol_file.write(name.data(), len);
+        symbols_pending = true;
+        return id;
+    }
+
+    void index(const EventRecord& r) {
+        if (r.asset != NO_SYMBOL) assets.postings[r.asset].push_back(r.sequence);
+        if (r.from != NO_SYMBOL) addresses.postings[r.from].push_back(r.sequence);
+        if (r.to != NO_SYMBOL && r.to != r.from) addresses.postings[r.to].push_back(r.sequence);
+    }
+
+    std::filesystem::path segment_path(size_t index) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "events-%06zu.seg", index);
+        return directory / name;
+    }
+
+    void start_segment(const EventRecord& first) {
+        segments.push_back(Segment{first.sequence, {}});
+        segment_first_time.push_back(first.timestamp);
+        open_segment_file();
+    }
+
+    void open_segment_file() {
+        segment_file.close();
+        segment_file.clear();
+        size_t index = segments.empty() ? 0 : segments.size() - 1;
+        segment_file.open(segment_path(index), std::ios::binary | std::ios::app);
+        if (!segment_file) {
+            throw std::runtime_error("Cannot open event segment: " + segment_path(index).string());
+        }
+    }
+
+    // Replay the symbol dictionary; a torn trailing symbol is dropped so
+    // later appends start on a record boundary
+    void load_symbols() {
+        auto path = directory / "symbols.dat";
+        if (!std::filesystem::exists(path)) return;
+        uintmax_t bytes = std::filesystem::file_size(path);
+        uintmax_t complete = 0;
+        {
+            std::ifstream in(path, std::ios::binary);
+            char kind;
+            uint32_t len;
+            while (in.get(kind) && in.read(reinterpret_cast<char*>(&len), sizeof(len))) {
+                if (len > bytes - complete) break;
+                std::string name(len, '\0');
+                if (!in.read(&name[0], len)) break;
+                SymbolTable& table = static_cast<uint8_t>(kind) == SYMBOL_ASSET ? assets : addresses;
+                table.ids.emplace(name, static_cast<uint32_t>(table.names.size()));
+                table.names.push_back(std::move(name));
+                table.postings.emplace_back();
+                complete += 1 + sizeof(len) + len;
+            }
+        }
+        if (complete < bytes) std::filesystem::resize_file(path, complete);
+    }
+
+    // Replay segments and rebuild indexes; a torn trailing record is dropped
+    void load_segments() {
+        for (size_t index = 0; std::filesystem::exists(segment_path(index)); ++index) {
+            auto path = segment_path(index);
+            uintmax_t bytes = std::filesystem::file_size(path);
+            size_t count = static_cast<size_t>(bytes / sizeof(EventRecord));
+            if (bytes % sizeof(EventRecord)) {
+                std::filesystem::resize_file(path, count * sizeof(EventRecord));
+            }
+            if (count == 0) break;
+
+            Segment segment{next_sequence, std::vector<EventRecord>(count)};
+            std::ifstream in(path, std::ios::binary);
+            in.read(reinterpret_cast<char*>(segment.events.data()), count * sizeof(EventRecord));
+
+            for (const auto& r : segment.events) {
+                if (r.sequence != next_sequence) {
+                    throw std::runtime_error("Corrupt event segment: " + path.string());
+                }
+                index_loaded(r);
+                ++next_sequence;
+                last_timestamp = r.timestamp;
+            }
+            segment_first_time.push_back(segment.events.front().timestamp);
+            segments.push_back(std::move(segment));
+        }
+    }
+
+    void index_loaded(const EventRecord& r) {
+        if ((r.asset != NO_SYMBOL && r.asset >= assets.names.size()) ||
+            (r.from != NO_SYMBOL && r.from >= addresses.names.size()) ||
+            (r.to != NO_SYMBOL && r.to >= addresses.names.size())) {
+            throw std::runtime_error("Event references unknown symbol: " + std::to_string(r.sequence));
+        }
+        index(r);
+    }
+};
+
+} // namespace qOracle
+
+#endif // EVENT_STORE_HPP
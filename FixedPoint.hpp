@@ -0,0 +1,169 @@
+/*
+ * Fixed-Point Arithmetic for qOracle
+ * Checked decimal math for prices, quotes and token conversions
+ *
+ * Token amounts are integers in base units (qBTC 8 decimals, qUSD and
+ * BKPY 15) and prices carry their own decimal scale, so an amount times
+ * a price easily exceeds 64 bits before it is divided back down. Every
+ * product here is formed in unsigned __int128 and only narrowed after
+ * the division; a result that still does not fit reports failure
+ * instead of wrapping. When both operands fit in 32 bits the product is
+ * kept in 64 bits and the 128-bit divide is skipped.
+ *
+ * Rounding is explicit: Down for amounts paid out, Up for amounts owed,
+ * HalfUp/HalfEven for display and statistics.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef FIXED_POINT_HPP
+#define FIXED_POINT_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <limits>
+
+namespace qOracle {
+
+using uint128_t = unsigned __int128;
+
+enum class Rounding : uint8_t {
+    Down,       // Toward zero
+    Up,         // Away from zero
+    HalfUp,     // Nearest, ties away from zero
+    HalfEven    // Nearest, ties to even
+};
+
+constexpr unsigned MAX_DECIMALS = 19;   // 10^19 is the largest power of ten in 64 bits
+
+namespace detail {
+
+constexpr std::array<uint64_t, MAX_DECIMALS + 1> make_pow10() {
+    std::array<uint64_t, MAX_DECIMALS + 1> table{};
+    uint64_t value = 1;
+    for (unsigned i = 0; i <= MAX_DECIMALS; ++i) {
+        table[i] = value;
+        value *= 10;
+    }
+    return table;
+}
+
+constexpr std::array<uint64_t, MAX_DECIMALS + 1> POW10 = make_pow10();
+
+// Adjust a truncated quotient q = n / d for the remainder r
+template <typename T>
+constexpr T round_quotient(T q, T r, T d, Rounding mode) {
+    switch (mode) {
+        case Rounding::Down:     return q;
+        case Rounding::Up:       return q + (r != 0);
+        case Rounding::HalfUp:   return q + (r >= d - r);
+        case Rounding::HalfEven: return q + (r > d - r || (r == d - r && (q & 1)));
+    }
+    return q;
+}
+
+} // namespace detail
+
+constexpr uint64_t pow10(unsigned exp) { return detail::POW10[exp]; }
+
+// n / d rounded as requested; false if d is zero or the result exceeds 64 bits
+constexpr bool div_round(uint128_t n, uint64_t d, uint64_t& out, Rounding mode = Rounding::Down) {
+    if (d == 0) return false;
+    if ((n >> 64) == 0) {
+        uint64_t n64 = static_cast<uint64_t>(n);
+        out = detail::round_quotient<uint64_t>(n64 / d, n64 % d, d, mode);
+        return out >= n64 / d;              // Rounding up past UINT64_MAX wraps to a smaller value
+    }
+    uint128_t q = detail::round_quotient<uint128_t>(n / d, n % d, d, mode);
+    if (q > std::numeric_limits<uint64_t>::max()) return false;
+    out = static_cast<uint64_t>(q);
+    return true;
+}
+
+// a * b / d without intermediate overflow
+constexpr bool mul_div(uint64_t a, uint64_t b, uint64_t d, uint64_t& out, Rounding mode = Rounding::Down) {
+    if ((a >> 32) == 0 && (b >> 32) == 0) return div_round(uint128_t(a * b), d, out, mode);
+    return div_round(uint128_t(a) * b, d, out, mode);
+}
+
+// amount * price where price carries PriceDecimals decimals
+template <unsigned PriceDecimals>
+constexpr bool quote(uint64_t amount, uint64_t price, uint64_t& out, Rounding mode = Rounding::Down) {
+    static_assert(PriceDecimals <= MAX_DECIMALS, "Price scale must fit in 64 bits");
+    return mul_div(amount, price, pow10(PriceDecimals), out, mode);
+}
+
+// Re-express an amount with From decimals in To decimals, e.g. 8 -> 15
+template <unsigned From, unsigned To>
+constexpr bool rescale(uint64_t amount, uint64_t& out, Rounding mode = Rounding::Down) {
+    static_assert(From <= MAX_DECIMALS && To <= MAX_DECIMALS, "Decimal scale must fit in 64 bits");
+    if constexpr (To >= From) {
+        constexpr uint64_t factor = pow10(To - From);
+        if (amount > std::numeric_limits<uint64_t>::max() / factor) return false;
+        out = amount * factor;
+        return true;
+    } else {
+        return div_round(amount, pow10(From - To), out, mode);
+    }
+}
+
+inline bool rescale(uint64_t amount, unsigned from, unsigned to, uint64_t& out, Rounding mode = Rounding::Down) {
+    if (from > MAX_DECIMALS || to > MAX_DECIMALS) return false;
+    if (to >= from) {
+        uint64_t factor = pow10(to - from);
+        if (amount > std::numeric_limits<uint64_t>::max() / factor) return false;
+        out = amount * factor;
+        return true;
+    }
+    return div_round(amount, pow10(from - to), out, mode);
+}
+
+// Quote count amounts at one price. When the largest amount times price
+// fits in 64 bits (the common case) the loop runs on 64-bit lanes with a
+// constant divisor and no branches; otherwise each element takes the
+// 128-bit path. Entries that overflow are set to 0 and the call returns
+// false.
+template <unsigned PriceDecimals>
+bool quote_batch(const uint64_t* amounts, uint64_t* out, size_t count, uint64_t price,
+                 Rounding mode = Rounding::Down) {
+    static_assert(PriceDecimals <= MAX_DECIMALS, "Price scale must fit in 64 bits");
+    constexpr uint64_t SCALE = pow10(PriceDecimals);
+
+    uint64_t largest = 0;
+    for (size_t i = 0; i < count; ++i) largest = amounts[i] > largest ? amounts[i] : largest;
+
+    if (price == 0 || largest <= std::numeric_limits<uint64_t>::max() / price) {
+        // Rounding is hoisted out so each loop body stays straight-line
+        switch (mode) {
+            case Rounding::Down:
+                for (size_t i = 0; i < count; ++i) out[i] = amounts[i] * price / SCALE;
+                return true;
+            case Rounding::Up:
+                for (size_t i = 0; i < count; ++i) {
+                    uint64_t p = amounts[i] * price;
+                    out[i] = p / SCALE + (p % SCALE != 0);
+                }
+                return true;
+            default:
+                for (size_t i = 0; i < count; ++i) {
+                    uint64_t p = amounts[i] * price;
+                    out[i] = detail::round_quotient<uint64_t>(p / SCALE, p % SCALE, SCALE, mode);
+                }
+                return true;
+        }
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < count; ++i) {
+        if (!quote<PriceDecimals>(amounts[i], price, out[i], mode)) {
+            out[i] = 0;
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+} // namespace qOracle
+
+#endif // FIXED_POINT_HPP
@@ -0,0 +1,369 @@
+/*
+ * Open-Addressing Flat Hash Map for qOracle
+ * SwissTable-style layout with SIMD group probing
+ *
+ * Slots live in one contiguous array next to a byte array of control
+ * tags (7 bits of the hash per slot). A lookup compares 16 tags at once
+ * (SSE2 where available) and only touches slots whose tag matches, so a
+ * hit costs one cache line of tags plus one slot, with no per-node
+ * allocation. Callers on hot paths can compute hash_of(key) once and
+ * reuse it across find/insert.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef FLAT_HASH_MAP_HPP
+#define FLAT_HASH_MAP_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace qOracle {
+
+// Default hasher: std::hash followed by a 64-bit finalizer, because
+// std::hash on integers is the identity and the tags use the low bits
+template <class K>
+struct FlatHash {
+    size_t operator()(const K& key) const {
+        uint64_t h = static_cast<uint64_t>(std::hash<K>{}(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return static_cast<size_t>(h);
+    }
+};
+
+template <class K, class V, class Hash = FlatHash<K>, class KeyEqual = std::equal_to<K>>
+class FlatHashMap {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+
+private:
+    static constexpr size_t GROUP_WIDTH = 16;
+    static constexpr size_t MIN_CAPACITY = 16;
+    static constexpr int8_t CTRL_EMPTY = -128;    // 0b10000000
+    static constexpr int8_t CTRL_DELETED = -2;    // 0b11111110
+
+    using Slot = value_type;
+
+    int8_t* ctrl = nullptr;        // capacity + GROUP_WIDTH bytes (tail mirrors the head)
+    Slot* slots = nullptr;
+    size_t capacity = 0;           // Power of two, 0 when unallocated
+    size_t count = 0;
+    size_t growth_left = 0;
+    Hash hasher;
+    KeyEqual key_equal;
+
+    static size_t h1(size_t hash) { return hash >> 7; }
+    static int8_t h2(size_t hash) { return static_cast<int8_t>(hash & 0x7F); }
+    static bool is_full(int8_t c) { return c >= 0; }
+
+    // Bitmask of positions in the 16-byte group equal to tag
+    static uint32_t match(const int8_t* group, int8_t tag) {
+#if defined(__SSE2__)
+        __m128i ctrl_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), ctrl_bytes)));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+            if (group[i] == tag) mask |= 1u << i;
+        }
+        return mask;
+#endif
+    }
+
+    // Bitmask of positions that are empty or deleted
+    static uint32_t match_free(const int8_t* group) {
+#if defined(__SSE2__)
+        __m128i ctrl_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return static_cast<uint32_t>(_mm_movemask_epi8(ctrl_bytes));   // High bit set = not full
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+            if (!is_full(group[i])) mask |= 1u << i;
+        }
+        return mask;
+#endif
+    }
+
+    static int lowest_bit(uint32_t mask) { return __builtin_ctz(mask); }
+
+    static size_t max_load(size_t cap) { return cap - cap / 8; }  // 7/8 load factor
+
+    void set_ctrl(size_t i, int8_t tag) {
+        ctrl[i] = tag;
+        if (i < GROUP_WIDTH) ctrl[capacity + i] = tag;
+    }
+
+    size_t find_index(const K& key, size_t hash) const {
+        if (capacity == 0) return capacity;
+        size_t mask = capacity - 1;
+        size_t pos = h1(hash) & mask;
+        int8_t tag = h2(hash);
+
+        for (size_t step = GROUP_WIDTH;; step += GROUP_WIDTH) {
+            const int8_t* group = ctrl + pos;
+            for (uint32_t m = match(group, tag); m; m &= m - 1) {
+                size_t i = (pos + lowest_bit(m)) & mask;
+                if (key_equal(slots[i].first, key)) return i;
+            }
+            if (match(group, CTRL_EMPTY)) return capacity;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    // First empty-or-deleted slot on the probe sequence for hash
+    size_t find_free(size_t hash) const {
+        size_t mask = capacity - 1;
+        size_t pos = h1(hash) & mask;
+        for (size_t step = GROUP_WIDTH;; step += GROUP_WIDTH) {
+            uint32_t m = match_free(ctrl + pos);
+            if (m) return (pos + lowest_bit(m)) & mask;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    void allocate(size_t cap) {
+        capacity = cap;
+        ctrl = static_cast<int8_t*>(::operator new(cap + GROUP_WIDTH));
+        std::memset(ctrl, CTRL_EMPTY, cap + GROUP_WIDTH);
+        slots = static_cast<Slot*>(::operator new(cap * sizeof(Slot), std::align_val_t(alignof(Slot))));
+        growth_left = max_load(cap);
+    }
+
+    void deallocate() {
+        if (!capacity) return;
+        ::operator delete(ctrl);
+        ::operator delete(slots, std::align_val_t(alignof(Slot)));
+        ctrl = nullptr;
+        slots = nullptr;
+        capacity = 0;
+    }
+
+    void destroy_all() {
+        if (std::is_trivially_destructible<Slot>::value) return;
+        for (size_t i = 0; i < capacity; ++i) {
+            if (is_full(ctrl[i])) slots[i].~Slot();
+        }
+    }
+
+    void rehash_to(size_t new_capacity) {
+        int8_t* old_ctrl = ctrl;
+        Slot* old_slots = slots;
+        size_t old_capacity = capacity;
+
+        allocate(new_capacity);
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (!is_full(old_ctrl[i])) continue;
+            size_t hash = hasher(old_slots[i].first);
+            size_t dst = find_free(hash);
+            set_ctrl(dst, h2(hash));
+            new (&slots[dst]) Slot(std::move(const_cast<K&>(old_slots[i].first)), std::move(old_slots[i].second));
+            old_slots[i].~Slot();
+        }
+        growth_left -= count;
+
+        if (old_capacity) {
+            ::operator delete(old_ctrl);
+            ::operator delete(old_slots, std::align_val_t(alignof(Slot)));
+        }
+    }
+
+    // Make room for one more element; tombstone-heavy tables rehash in place
+    void reserve_one() {
+        if (growth_left > 0) return;
+        if (capacity == 0) {
+            rehash_to(MIN_CAPACITY);
+        } else if (count * 2 < max_load(capacity)) {
+            rehash_to(capacity);
+        } else {
+            rehash_to(capacity * 2);
+        }
+    }
+
+    template <class KeyArg, class... Args>
+    std::pair<size_t, bool> emplace_hashed(size_t hash, KeyArg&& key, Args&&... args) {
+        size_t found = find_index(key, hash);
+        if (found != capacity) return {found, false};
+
+        reserve_one();
+        size_t i = find_free(hash);
+        if (ctrl[i] == CTRL_EMPTY) --growth_left;
+        set_ctrl(i, h2(hash));
+        new (&slots[i]) Slot(std::piecewise_construct,
+                             std::forward_as_tuple(std::forward<KeyArg>(key)),
+                             std::forward_as_tuple(std::forward<Args>(args)...));
+        ++count;
+        return {i, true};
+    }
+
+    template <class MapPtr, class Ref, class Ptr>
+    class basic_iterator {
+        friend class FlatHashMap;
+        MapPtr map;
+        size_t index;
+
+        void skip_empty() {
+            while (index < map->capacity && !is_full(map->ctrl[index])) ++index;
+        }
+
+    public:
+        basic_iterator(MapPtr m, size_t i) : map(m), index(i) { skip_empty(); }
+        Ref operator*() const { return map->slots[index]; }
+        Ptr operator->() const { return &map->slots[index]; }
+        basic_iterator& operator++() { ++index; skip_empty(); return *this; }
+        bool operator==(const basic_iterator& other) const { return index == other.index; }
+        bool operator!=(const basic_iterator& other) const { return index != other.index; }
+    };
+
+public:
+    using iterator = basic_iterator<FlatHashMap*, value_type&, value_type*>;
+    using const_iterator = basic_iterator<const FlatHashMap*, const value_type&, const value_type*>;
+
+    FlatHashMap() = default;
+    explicit FlatHashMap(size_t expected) { reserve(expected); }
+    ~FlatHashMap() { destroy_all(); deallocate(); }
+
+    FlatHashMap(const FlatHashMap&) = delete;
+    FlatHashMap& operator=(const FlatHashMap&) = delete;
+
+    FlatHashMap(FlatHashMap&& other) noexcept { swap(other); }
+    FlatHashMap& operator=(FlatHashMap&& other) noexcept {
+        if (this != &other) {
+            clear();
+            deallocate();
+            swap(other);
+        }
+        return *this;
+    }
+
+    void swap(FlatHashMap& other) noexcept {
+        std::swap(ctrl, other.ctrl);
+        std::swap(slots, other.slots);
+        std::swap(capacity, other.capacity);
+        std::swap(count, other.count);
+        std::swap(growth_left, other.growth_left);
+    }
+
+    size_t hash_of(const K& key) const { return hasher(key); }
+
+    iterator find(const K& key) { return find(key, hasher(key)); }
+    const_iterator find(const K& key) const { return find(key, hasher(key)); }
+    iterator find(const K& key, size_t hash) { return iterator(this, find_index(key, hash)); }
+    const_iterator find(const K& key, size_t hash) const { return const_iterator(this, find_index(key, hash)); }
+
+    bool contains(const K& key) const { return find_index(key, hasher(key)) != capacity; }
+
+    V& operator[](const K& key) {
+        size_t i = emplace_hashed(hasher(key), key).first;
+        return slots[i].second;
+    }
+
+    V& at_hashed(const K& key, size_t hash) {
+        size_t i = emplace_hashed(hash, key).first;
+        return slots[i].second;
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> emplace(const K& key, Args&&... args) {
+        auto result = emplace_hashed(hasher(key), key, std::forward<Args>(args)...);
+        return {iterator(this, result.first), result.second};
+    }
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const K& key, M&& value) {
+        auto result = emplace_hashed(hasher(key), key);
+        slots[result.first].second = std::forward<M>(value);
+        return {iterator(this, result.first), result.second};
+    }
+
+    size_t erase(const K& key) {
+        size_t i = find_index(key, hasher(key));
+        if (i == capacity) return 0;
+        erase_at(i);
+        return 1;
+    }
+
+    void erase(iterator it) { erase_at(it.index); }
+
+    void clear() {
+        destroy_all();
+        if (capacity) {
+            std::memset(ctrl, CTRL_EMPTY, capacity + GROUP_WIDTH);
+            growth_left = max_load(capacity);
+        }
+        count = 0;
+    }
+
+    void reserve(size_t n) {
+        size_t cap = MIN_CAPACITY;
+        while (max_load(cap) < n) cap *= 2;
+        if (cap > capacity) rehash_to(cap);
+    }
+
+    // Shrink to the smallest capacity holding size() elements
+    void shrink_to_fit() {
+        if (count == 0) {
+            clear();
+            deallocate();
+            growth_left = 0;
+            return;
+        }
+        size_t cap = MIN_CAPACITY;
+        while (max_load(cap) < count) cap *= 2;
+        if (cap < capacity) rehash_to(cap);
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, capacity); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, capacity); }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t bucket_count() const { return capacity; }
+
+    // Heap bytes held by the table itself (excludes memory owned by keys/values)
+    size_t memory_bytes() const {
+        return capacity ? capacity * sizeof(Slot) + capacity + GROUP_WIDTH : 0;
+    }
+
+private:
+    void erase_at(size_t i) {
+        slots[i].~Slot();
+        // A slot can go straight back to EMPTY if its group never filled up,
+        // since no probe sequence can have continued past it
+        size_t mask = capacity - 1;
+        size_t before = (i - GROUP_WIDTH) & mask;
+        uint32_t empty_after = match(ctrl + i, CTRL_EMPTY);
+        uint32_t empty_before = match(ctrl + before, CTRL_EMPTY);
+        bool was_never_full = empty_after && empty_before &&
+            static_cast<size_t>(__builtin_ctz(empty_after) + (__builtin_clz(empty_before) - 16)) < GROUP_WIDTH;
+        if (was_never_full) {
+            set_ctrl(i, CTRL_EMPTY);
+            ++growth_left;
+        } else {
+            set_ctrl(i, CTRL_DELETED);
+        }
+        --count;
+    }
+};
+
+} // namespace qOracle
+
+#endif // FLAT_HASH_MAP_HPP
@@ -0,0 +1,129 @@
+/*
+ * Typed Governance Actions for qOracle
+ * Proposal actions compiled once, dispatched through a jump table
+ *
+ * A proposal names its action and parameter as strings. compile()
+ * resolves them when the proposal is created: the name becomes a
+ * GovernanceAction index and the parameter a range-checked integer, so
+ * a malformed proposal is rejected before anyone signs it. Execution
+ * then indexes ActionTable by the action and calls the bound handler
+ * with the stored argument; no strings are compared or allocated.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef GOVERNANCE_ACTIONS_HPP
+#define GOVERNANCE_ACTIONS_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <string>
+#include <functional>
+#include "QuantumSignature.hpp"
+#include "VolumeLimiter.hpp"
+
+namespace qOracle {
+
+enum class GovernanceAction : uint8_t {
+    Signal,                 // Recorded vote with no on-chain effect
+    PauseOracle,            // Emergency-pause the oracle committee
+    ResumeOracle,
+    DeactivateOracle,       // Argument: oracle index
+    ActivateOracle,         // Argument: oracle index
+    SetSwapNetting,         // Argument: 0 or 1
+    SetDailyVolumeLimit,    // Argument: bridge-wide limit per sliding day
+    SetAccountVolumeLimit,  // Argument: per-account limit per sliding day
+    COUNT
+};
+
+constexpr size_t GOVERNANCE_ACTION_COUNT = static_cast<size_t>(GovernanceAction::COUNT);
+
+// An action with its validated argument
+struct GovernanceCommand {
+    GovernanceAction action = GovernanceAction::Signal;
+    uint64_t argument = 0;
+};
+
+struct GovernanceActionSpec {
+    const char* name;
+    bool takes_argument;
+    uint64_t min_argument;
+    uint64_t max_argument;
+};
+
+constexpr std::array<GovernanceActionSpec, GOVERNANCE_ACTION_COUNT> GOVERNANCE_ACTIONS = {{
+    {"signal",                   false, 0, 0},
+    {"pause_oracle",             false, 0, 0},
+    {"resume_oracle",            false, 0, 0},
+    {"deactivate_oracle",        true,  0, NUM_ORACLES - 1},
+    {"activate_oracle",          true,  0, NUM_ORACLES - 1},
+    {"set_swap_netting",         true,  0, 1},
+    {"set_daily_volume_limit",   true,  1, VolumeLimiter::MAX_LIMIT},
+    {"set_account_volume_limit", true,  1, VolumeLimiter::MAX_LIMIT},
+}};
+
+inline const char* action_name(GovernanceAction action) {
+    size_t index = static_cast<size_t>(action);
+    return index < GOVERNANCE_ACTION_COUNT ? GOVERNANCE_ACTIONS[index].name : "unknown";
+}
+
+// Resolve an action name and its decimal parameter; false if either is
+// invalid. Unknown names are rejected rather than treated as no-ops, so a
+// free-form proposal (one whose effect lives in to/value/data, or off
+// chain) must name "signal" with an empty parameter.
+inline bool compile(const std::string& action, const std::string& parameter, GovernanceCommand& out) {
+    for (size_t i = 0; i < GOVERNANCE_ACTION_COUNT; ++i) {
+        const GovernanceActionSpec& spec = GOVERNANCE_ACTIONS[i];
+        if (action != spec.name) continue;
+
+        out.action = static_cast<GovernanceAction>(i);
+        out.argument = 0;
+        if (!spec.takes_argument) return parameter.empty();
+        if (parameter.empty() || parameter.size() > 20) return false;
+
+        uint64_t value = 0;
+        for (char c : parameter) {
+            if (c < '0' || c > '9') return false;
+            uint64_t digit = static_cast<uint64_t>(c - '0');
+            if (value > (UINT64_MAX - digit) / 10) return false;
+            value = value * 10 + digit;
+        }
+        if (value < spec.min_argument || value > spec.max_argument) return false;
+        out.argument = value;
+        return true;
+    }
+    return false;
+}
+
+// Handlers indexed by action. A handler returns false (or throws) when
+// the action could not take effect; Signal always succeeds.
+class ActionTable {
+public:
+    using Handler = std::function<bool(uint64_t argument)>;
+
+private:
+    std::array<Handler, GOVERNANCE_ACTION_COUNT> handlers;
+
+public:
+    ActionTable() {
+        handlers[static_cast<size_t>(GovernanceAction::Signal)] = [](uint64_t) { return true; };
+    }
+
+    void bind(GovernanceAction action, Handler handler) {
+        handlers[static_cast<size_t>(action)] = std::move(handler);
+    }
+
+    bool bound(GovernanceAction action) const {
+        return static_cast<bool>(handlers[static_cast<size_t>(action)]);
+    }
+
+    bool dispatch(const GovernanceCommand& command) const {
+        const Handler& handler = handlers[static_cast<size_t>(command.action)];
+        return handler && handler(command.argument);
+    }
+};
+
+} // namespace qOracle
+
+#endif // GOVERNANCE_ACTIONS_HPP
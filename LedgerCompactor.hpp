@@ -0,0 +1,92 @@
+/*
+ * Background Ledger Compactor for qOracle
+ * Periodically releases balance chunks that hold only zero balances
+ *
+ * Accounts drained to zero keep their slot until the whole chunk they
+ * live in is empty; the compactor then hands the chunk back to the
+ * allocator. A later credit to any of those ids reallocates it lazily.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef LEDGER_COMPACTOR_HPP
+#define LEDGER_COMPACTOR_HPP
+
+#include <cstdint>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include "BalanceTable.hpp"
+
+namespace qOracle {
+
+class LedgerCompactor {
+private:
+    std::vector<BalanceTable*> tables;
+    std::chrono::seconds interval;
+    std::function<void(const LedgerStats&)> on_pass;
+
+    std::thread worker;
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    void run() {
+        std::unique_lock<std::mutex> lock(wake_mutex);
+        while (!stopping) {
+            if (wake.wait_for(lock, interval, [this] { return stopping; })) break;
+            lock.unlock();
+            run_once();
+            lock.lock();
+        }
+    }
+
+public:
+    // on_pass receives the summed stats after every compaction pass
+    explicit LedgerCompactor(std::vector<BalanceTable*> ledgers, std::chrono::seconds every,
+                             std::function<void(const LedgerStats&)> callback = nullptr)
+        : tables(std::move(ledgers)), interval(every), on_pass(std::move(callback)) {}
+
+    LedgerCompactor(const LedgerCompactor&) = delete;
+    LedgerCompactor& operator=(const LedgerCompactor&) = delete;
+
+    ~LedgerCompactor() { stop(); }
+
+    void start() {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        if (worker.joinable()) return;
+        stopping = false;
+        worker = std::thread([this] { run(); });
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        if (worker.joinable()) worker.join();
+    }
+
+    // One synchronous pass over every ledger
+    LedgerStats run_once() {
+        LedgerStats total;
+        for (BalanceTable* table : tables) {
+            LedgerStats stats = table->compact();
+            total.allocated_chunks += stats.allocated_chunks;
+            total.live_accounts += stats.live_accounts;
+            total.ledger_bytes += stats.ledger_bytes;
+            total.released_chunks += stats.released_chunks;
+        }
+        total.bytes_per_account = total.live_accounts ? total.ledger_bytes / total.live_accounts : 0;
+        if (on_pass) on_pass(total);
+        return total;
+    }
+};
+
+} // namespace qOracle
+
+#endif // LEDGER_COMPACTOR_HPP
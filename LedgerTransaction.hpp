@@ -0,0 +1,142 @@
+/*
+ * Cross-Ledger Transactions for qOracle
+ * Stage debits, credits, mints and burns over several ledgers and
+ * apply them as one
+ *
+ * commit() takes the stripes of every touched account across all
+ * participating ledgers in the global order (see lock_stripes) and
+ * replays the staged operations, in the order they were added, against
+ * a private view. If any debit or burn lacks funds nothing is written.
+ * Otherwise the net change per account is applied, debits first, and
+ * supply counters move last; no other striped writer ever observes a
+ * partial transaction.
+ *
+ * Ledgers in LockFree mode let single transfers bypass stripes. A racing
+ * transfer can then drain an account between the view and the write;
+ * the applied debits are credited back and commit() fails, so funds are
+ * never lost or created, but a lock-free reader may glimpse the debit.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef LEDGER_TRANSACTION_HPP
+#define LEDGER_TRANSACTION_HPP
+
+#include <cstdint>
+#include <vector>
+#include <atomic>
+#include "AddressRegistry.hpp"
+#include "BalanceTable.hpp"
+#include "ShardedCounter.hpp"
+
+namespace qOracle {
+
+class LedgerTransaction {
+private:
+    enum class OpKind : uint8_t { Credit, Debit, Mint, Burn };
+
+    struct Op {
+        BlockLedger ledger;
+        OpKind kind;
+        AccountId account;
+        uint64_t amount;
+    };
+
+    std::vector<Op> ops;
+    bool committed = false;
+
+    LedgerTransaction& stage(const BlockLedger& ledger, OpKind kind, AccountId account, uint64_t amount) {
+        ops.push_back(Op{ledger, kind, account, amount});
+        return *this;
+    }
+
+    static bool is_debit(OpKind kind) { return kind == OpKind::Debit || kind == OpKind::Burn; }
+
+public:
+    LedgerTransaction& credit(const BlockLedger& ledger, AccountId account, uint64_t amount) {
+        return stage(ledger, OpKind::Credit, account, amount);
+    }
+    LedgerTransaction& debit(const BlockLedger& ledger, AccountId account, uint64_t amount) {
+        return stage(ledger, OpKind::Debit, account, amount);
+    }
+    // Credit plus a supply increase (ledger.supply may be null)
+    LedgerTransaction& mint(const BlockLedger& ledger, AccountId account, uint64_t amount) {
+        return stage(ledger, OpKind::Mint, account, amount);
+    }
+    // Debit plus a supply decrease
+    LedgerTransaction& burn(const BlockLedger& ledger, AccountId account, uint64_t amount) {
+        return stage(ledger, OpKind::Burn, account, amount);
+    }
+
+    size_t size() const { return ops.size(); }
+
+    // Apply every staged operation or none. A transaction commits once.
+    bool commit() {
+        if (committed) return false;
+        committed = true;
+        for (const Op& op : ops) {
+            if (op.account == INVALID_ACCOUNT || op.amount == 0) return false;
+        }
+
+        std::vector<StripeRequest> stripes;
+        stripes.reserve(ops.size());
+        for (const Op& op : ops) stripes.push_back({op.ledger.balances, BalanceTable::shard_bit(op.account)});
+        auto guards = lock_stripes(std::move(stripes));
+
+        // Replay against a private view so an operation may spend funds
+        // credited earlier in the same transaction
+        struct Net {
+            BalanceTable* table;
+            AccountId account;
+            uint64_t balance;
+            uint64_t debited;
+            uint64_t credited;
+        };
+        std::vector<Net> view;
+        auto touch = [&](const Op& op) -> Net& {
+            for (Net& net : view) {
+                if (net.table == op.ledger.balances && net.account == op.account) return net;
+            }
+            view.push_back(Net{op.ledger.balances, op.account, op.ledger.balances->load(op.account), 0, 0});
+            return view.back();
+        };
+        for (const Op& op : ops) {
+            Net& net = touch(op);
+            if (is_debit(op.kind)) {
+                if (net.balance < op.amount) return false;
+                net.balance -= op.amount;
+                net.debited += op.amount;
+            } else {
+                net.balance += op.amount;
+                net.credited += op.amount;
+            }
+        }
+
+        // Net debits first: backing out then only ever needs credits, which
+        // cannot fail even if a lock-free transfer raced us
+        for (size_t i = 0; i < view.size(); ++i) {
+            const Net& net = view[i];
+            if (net.debited <= net.credited) continue;
+            if (net.table->debit_unlocked(net.account, net.debited - net.credited)) continue;
+            while (i-- > 0) {
+                const Net& undo = view[i];
+                if (undo.debited > undo.credited) undo.table->credit_unlocked(undo.account, undo.debited - undo.credited);
+            }
+            return false;
+        }
+        for (const Net& net : view) {
+            if (net.credited > net.debited) net.table->credit_unlocked(net.account, net.credited - net.debited);
+        }
+
+        for (const Op& op : ops) {
+            if (!op.ledger.supply) continue;
+            if (op.kind == OpKind::Mint) op.ledger.supply->add(op.amount);
+            else if (op.kind == OpKind::Burn) op.ledger.supply->sub(op.amount);
+        }
+        return true;
+    }
+};
+
+} // namespace qOracle
+
+#endif // LEDGER_TRANSACTION_HPP
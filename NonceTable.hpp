@@ -0,0 +1,127 @@
+/*
+ * Nonce-Indexed Segmented Table for qOracle
+ * Dense storage for records keyed by increasing nonces
+ *
+ * Governance nonces start at a base and only ever grow by one, so a
+ * nonce is an index: segment = (nonce - base) / 256, slot = the rest.
+ * Each segment pairs a compact Record array with a lazily allocated
+ * array of owning pointers to full Live entries. Archiving a nonce
+ * writes its Record and frees its Live entry; once a whole segment is
+ * archived its pointer array is released too, leaving only the records.
+ * Lookups are two array indexings and segments never move, so pointers
+ * to entries stay valid until they are archived.
+ *
+ * The table is not synchronized; its owner locks.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef NONCE_TABLE_HPP
+#define NONCE_TABLE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <memory>
+#include <vector>
+#include <utility>
+
+namespace qOracle {
+
+template <typename Live, typename Record>
+class NonceTable {
+public:
+    static constexpr size_t SEGMENT_BITS = 8;
+    static constexpr size_t SEGMENT_SIZE = size_t(1) << SEGMENT_BITS;
+
+private:
+    using LiveSlots = std::array<std::unique_ptr<Live>, SEGMENT_SIZE>;
+
+    struct Segment {
+        std::array<Record, SEGMENT_SIZE> records{};
+        std::unique_ptr<LiveSlots> live{new LiveSlots()};
+        size_t live_count = 0;
+        size_t archived_count = 0;
+    };
+
+    const uint64_t base;
+    uint64_t next;
+    std::vector<std::unique_ptr<Segment>> segments;
+    size_t live_total = 0;
+    size_t archived_total = 0;
+
+    Segment* segment_of(uint64_t nonce) const {
+        if (nonce < base || nonce >= next) return nullptr;
+        return segments[(nonce - base) >> SEGMENT_BITS].get();
+    }
+
+    static size_t slot_of(uint64_t offset) { return offset & (SEGMENT_SIZE - 1); }
+
+public:
+    explicit NonceTable(uint64_t first_nonce = 1) : base(first_nonce), next(first_nonce) {}
+
+    NonceTable(const NonceTable&) = delete;
+    NonceTable& operator=(const NonceTable&) = delete;
+
+    // Append the entry for the next nonce; returns nullptr if nonce is not next
+    Live* append(uint64_t nonce, Live value) {
+        if (nonce != next) return nullptr;
+        uint64_t offset = nonce - base;
+        if (slot_of(offset) == 0) segments.push_back(std::unique_ptr<Segment>(new Segment()));
+        Segment& segment = *segments.back();
+        auto& slot = (*segment.live)[slot_of(offset)];
+        slot.reset(new Live(std::move(value)));
+        segment.live_count++;
+        live_total++;
+        next++;
+        return slot.get();
+    }
+
+    // Live entry for nonce, or nullptr if unknown or archived
+    Live* find(uint64_t nonce) const {
+        Segment* segment = segment_of(nonce);
+        if (!segment || !segment->live) return nullptr;
+        return (*segment->live)[slot_of(nonce - base)].get();
+    }
+
+    // Archived record for nonce, or nullptr if unknown or still live
+    const Record* archived(uint64_t nonce) const {
+        Segment* segment = segment_of(nonce);
+        if (!segment || find(nonce)) return nullptr;
+        return &segment->records[slot_of(nonce - base)];
+    }
+
+    // Replace a live entry with its compact record
+    bool archive(uint64_t nonce, const Record& record) {
+        Segment* segment = segment_of(nonce);
+        if (!segment || !segment->live) return false;
+        auto& slot = (*segment->live)[slot_of(nonce - base)];
+        if (!slot) return false;
+        segment->records[slot_of(nonce - base)] = record;
+        slot.reset();
+        segment->live_count--;
+        segment->archived_count++;
+        live_total--;
+        archived_total++;
+        if (segment->archived_count == SEGMENT_SIZE) segment->live.reset();
+        return true;
+    }
+
+    uint64_t next_nonce() const { return next; }
+    size_t live_size() const { return live_total; }
+    size_t archived_size() const { return archived_total; }
+
+    // Table overhead plus live entries, not counting memory the entries own
+    size_t memory_bytes() const {
+        size_t bytes = segments.capacity() * sizeof(std::unique_ptr<Segment>);
+        for (const auto& segment : segments) {
+            bytes += sizeof(Segment);
+            if (segment->live) bytes += sizeof(LiveSlots);
+        }
+        return bytes + live_total * sizeof(Live);
+    }
+};
+
+} // namespace qOracle
+
+#endif // NONCE_TABLE_HPP
@@ -0,0 +1,82 @@
+/*
+ * Simulated Oracle Committee for qOracle
+ * Locally signed price updates for benchmarks and load generation
+ *
+ * Holds NUM_ORACLES deterministic key pairs and produces signatures that
+ * QuantumSignatureVerifier accepts, so tools can drive the committee
+ * without a live Qubic node or real oracle operators. The verifier's
+ * Dilithium3 check is still the hash-based placeholder; sign() mirrors
+ * it by searching for a signature whose check bit is set, which takes
+ * two attempts on average. Replace both sides together when real
+ * Dilithium3 lands.
+ *
+ * Not for production use: the "private keys" are the public keys.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef ORACLE_SIMULATOR_HPP
+#define ORACLE_SIMULATOR_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <string>
+#include <vector>
+#include <openssl/evp.h>
+#include "QuantumSignature.hpp"
+
+namespace qOracle {
+
+class OracleSimulator {
+private:
+    std::array<Dilithium3PubKey, NUM_ORACLES> keys;
+    std::array<std::string, NUM_ORACLES> addresses;
+
+    // The verifier's placeholder check: SHA-256(pubkey || H(msg) || sig), low bit of byte 0
+    static bool accepted(const Dilithium3PubKey& key, const std::array<uint8_t, 32>& digest,
+                         const Dilithium3Signature& signature) {
+        std::array<uint8_t, 32> hash{};
+        EVP_MD_CTX* ctx = EVP_MD_CTX_new();
+        if (!ctx) return false;
+        bool ok = EVP_DigestInit_ex(ctx, EVP_sha256(), nullptr) == 1 &&
+                  EVP_DigestUpdate(ctx, key.data(), key.size()) == 1 &&
+                  EVP_DigestUpdate(ctx, digest.data(), digest.size()) == 1 &&
+                  EVP_DigestUpdate(ctx, signature.data(), signature.size()) == 1 &&
+                  EVP_DigestFinal_ex(ctx, hash.data(), nullptr) == 1;
+        EVP_MD_CTX_free(ctx);
+        return ok && (hash[0] & 0x01) == 0x01;
+    }
+
+public:
+    explicit OracleSimulator(uint8_t seed = 1) {
+        for (size_t i = 0; i < NUM_ORACLES; ++i) {
+            keys[i].fill(static_cast<uint8_t>(seed + i));
+            addresses[i] = "SIMORACLE" + std::to_string(i + 1);
+        }
+    }
+
+    const std::array<Dilithium3PubKey, NUM_ORACLES>& public_keys() const { return keys; }
+    const std::array<std::string, NUM_ORACLES>& oracle_addresses() const { return addresses; }
+
+    Dilithium3Signature sign(size_t oracle, const PriceMessage& message) const {
+        std::array<uint8_t, 32> digest = message.hash();
+        Dilithium3Signature signature{};
+        std::memcpy(signature.data(), digest.data(), digest.size());
+        for (uint64_t attempt = 0;; ++attempt) {
+            std::memcpy(signature.data() + digest.size(), &attempt, sizeof(attempt));
+            if (accepted(keys[oracle], digest, signature)) return signature;
+        }
+    }
+
+    // Update signed by the first signers oracles
+    PriceUpdate make_update(const PriceMessage& message, size_t signers = NUM_ORACLES) const {
+        PriceUpdate update(message);
+        for (size_t i = 0; i < signers && i < NUM_ORACLES; ++i) update.add_signature(i, sign(i, message));
+        return update;
+    }
+};
+
+} // namespace qOracle
+
+#endif // ORACLE_SIMULATOR_HPP
@@ -0,0 +1,372 @@
+/*
+ * Profiled Mutex for qOracle
+ * Drop-in std::mutex replacement that measures its own contention
+ *
+ * With QORACLE_LOCK_PROFILING set to 1 every ProfiledMutex records, per
+ * lock, how many acquisitions had to wait, how long they waited and how
+ * long the lock was then held. Waits and holds go into log2-nanosecond
+ * histograms of relaxed atomic counters, so recording never takes a
+ * lock of its own. A contended acquisition is also charged to its call
+ * site (the return address of lock()) in a small per-lock table.
+ *
+ * lock_report() merges instances that share a name (the 64 stripes of a
+ * balance table report as one lock) and ranks them by total wait time.
+ * Call sites are symbolized with dladdr where available; link with
+ * -rdynamic for names, otherwise feed the addresses to addr2line.
+ *
+ * With profiling off (the default) ProfiledMutex is a plain std::mutex
+ * with a name argument that compiles away, and lock_report() is empty.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef PROFILED_MUTEX_HPP
+#define PROFILED_MUTEX_HPP
+
+#ifndef QORACLE_LOCK_PROFILING
+#define QORACLE_LOCK_PROFILING 0
+#endif
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if QORACLE_LOCK_PROFILING
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#if defined(__has_include)
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#define QORACLE_HAVE_DLADDR 1
+#endif
+#endif
+#endif
+
+namespace qOracle {
+
+// Nanosecond latencies bucketed by power of two: bucket i holds [2^i, 2^(i+1))
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKETS = 40;   // Up to ~9 minutes
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> counts{};
+    std::atomic<uint64_t> sum{0};
+
+public:
+    void record(uint64_t ns) {
+        size_t bucket = ns ? 63 - __builtin_clzll(ns) : 0;
+        counts[bucket < BUCKETS ? bucket : BUCKETS - 1].fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    void merge_into(std::array<uint64_t, BUCKETS>& out, uint64_t& total_ns) const {
+        for (size_t i = 0; i < BUCKETS; ++i) out[i] += counts[i].load(std::memory_order_relaxed);
+        total_ns += sum.load(std::memory_order_relaxed);
+    }
+
+    void reset() {
+        for (auto& count : counts) count.store(0, std::memory_order_relaxed);
+        sum.store(0, std::memory_order_relaxed);
+    }
+
+    // Upper bound of the bucket holding the q-quantile
+    static uint64_t quantile(const std::array<uint64_t, BUCKETS>& counts, double q) {
+        uint64_t total = 0;
+        for (uint64_t c : counts) total += c;
+        if (total == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            seen += counts[i];
+            if (seen >= rank) return (uint64_t(1) << (i + 1)) - 1;
+        }
+        return ~uint64_t(0);
+    }
+};
+
+struct LockCaller {
+    std::string site;               // Symbol+offset, or a raw address
+    uint64_t contended = 0;
+    uint64_t wait_ns = 0;
+};
+
+// One named lock, summed over every instance with that name
+struct LockReport {
+    std::string name;
+    size_t instances = 0;
+    uint64_t acquisitions = 0;
+    uint64_t contended = 0;
+    uint64_t wait_ns = 0;
+    uint64_t hold_ns = 0;
+    uint64_t wait_p50_ns = 0;
+    uint64_t wait_p99_ns = 0;
+    uint64_t hold_p50_ns = 0;
+    uint64_t hold_p99_ns = 0;
+    std::vector<LockCaller> callers;    // Heaviest waiters first
+};
+
+#if QORACLE_LOCK_PROFILING
+
+class ProfiledMutex;
+
+namespace detail {
+
+// Every live ProfiledMutex, for reporting
+struct LockRegistry {
+    std::mutex mutex;
+    std::vector<ProfiledMutex*> locks;
+};
+
+inline LockRegistry& lock_registry() {
+    static LockRegistry registry;
+    return registry;
+}
+
+inline uint64_t lock_clock_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+inline std::string describe_site(uintptr_t address) {
+    char buffer[32];
+#ifdef QORACLE_HAVE_DLADDR
+    Dl_info info;
+    if (dladdr(reinterpret_cast<void*>(address), &info) && info.dli_sname) {
+        std::snprintf(buffer, sizeof(buffer), "+0x%zx",
+                      static_cast<size_t>(address - reinterpret_cast<uintptr_t>(info.dli_saddr)));
+        return info.dli_sname + std::string(buffer);
+    }
+#endif
+    std::snprintf(buffer, sizeof(buffer), "0x%zx", static_cast<size_t>(address));
+    return buffer;
+}
+
+} // namespace detail
+
+class ProfiledMutex {
+public:
+    static constexpr size_t CALLER_SLOTS = 8;
+
+private:
+    struct CallerSlot {
+        std::atomic<uintptr_t> site{0};
+        std::atomic<uint64_t> contended{0};
+        std::atomic<uint64_t> wait_ns{0};
+    };
+
+    struct Stats {
+        std::atomic<uint64_t> acquisitions{0};
+        std::atomic<uint64_t> contended{0};
+        LatencyHistogram wait;
+        LatencyHistogram hold;
+        std::array<CallerSlot, CALLER_SLOTS> callers;
+        CallerSlot other;                       // Sites that found the table full
+    };
+
+    std::mutex mutex;
+    const char* lock_name;
+    uint64_t acquired_at = 0;                   // Written only by the holder
+    std::unique_ptr<Stats> stats{new Stats()};
+
+    void charge_caller(uintptr_t site, uint64_t wait_ns) {
+        CallerSlot* slot = &stats->other;
+        for (size_t i = 0, start = (site >> 4) % CALLER_SLOTS; i < CALLER_SLOTS; ++i) {
+            CallerSlot& candidate = stats->callers[(start + i) % CALLER_SLOTS];
+            uintptr_t seen = candidate.site.load(std::memory_order_relaxed);
+            if (seen == 0 && candidate.site.compare_exchange_strong(seen, site)) seen = site;
+            if (seen == site) {
+                slot = &candidate;
+                break;
+            }
+        }
+        slot->contended.fetch_add(1, std::memory_order_relaxed);
+        slot->wait_ns.fetch_add(wait_ns, std::memory_order_relaxed);
+    }
+
+    friend std::vector<LockReport> lock_report(size_t);
+    friend void reset_lock_stats();
+
+public:
+    explicit ProfiledMutex(const char* name = "unnamed") : lock_name(name) {
+        auto& registry = detail::lock_registry();
+        std::lock_guard<std::mutex> guard(registry.mutex);
+        registry.locks.push_back(this);
+    }
+
+    ~ProfiledMutex() {
+        auto& registry = detail::lock_registry();
+        std::lock_guard<std::mutex> guard(registry.mutex);
+        registry.locks.erase(std::find(registry.locks.begin(), registry.locks.end(), this));
+    }
+
+    ProfiledMutex(const ProfiledMutex&) = delete;
+    ProfiledMutex& operator=(const ProfiledMutex&) = delete;
+
+    // Not inlined so the return address names the caller
+    [[gnu::noinline]] void lock() {
+        uint64_t start = detail::lock_clock_ns();
+        if (!mutex.try_lock()) {
+            mutex.lock();
+            uint64_t waited = detail::lock_clock_ns() - start;
+            stats->contended.fetch_add(1, std::memory_order_relaxed);
+            stats->wait.record(waited);
+            charge_caller(reinterpret_cast<uintptr_t>(__builtin_return_address(0)), waited);
+            start += waited;
+        } else {
+            stats->wait.record(0);
+        }
+        stats->acquisitions.fetch_add(1, std::memory_order_relaxed);
+        acquired_at = start;
+    }
+
+    bool try_lock() {
+        if (!mutex.try_lock()) return false;
+        stats->acquisitions.fetch_add(1, std::memory_order_relaxed);
+        acquired_at = detail::lock_clock_ns();
+        return true;
+    }
+
+    void unlock() {
+        uint64_t held = detail::lock_clock_ns() - acquired_at;
+        mutex.unlock();
+        stats->hold.record(held);
+    }
+
+    const char* name() const { return lock_name; }
+};
+
+// Locks ranked by total wait, at most top of them, each with its top callers
+inline std::vector<LockReport> lock_report(size_t top = 10) {
+    struct Merged {
+        LockReport report;
+        std::array<uint64_t, LatencyHistogram::BUCKETS> wait{};
+        std::array<uint64_t, LatencyHistogram::BUCKETS> hold{};
+        std::vector<std::pair<uintptr_t, LockCaller>> callers;
+    };
+    std::vector<Merged> merged;
+
+    {
+        auto& registry = detail::lock_registry();
+        std::lock_guard<std::mutex> guard(registry.mutex);
+        for (const ProfiledMutex* lock : registry.locks) {
+            auto it = std::find_if(merged.begin(), merged.end(),
+                                   [&](const Merged& m) { return m.report.name == lock->lock_name; });
+            if (it == merged.end()) {
+                merged.emplace_back();
+                it = merged.end() - 1;
+                it->report.name = lock->lock_name;
+            }
+            const auto& stats = *lock->stats;
+            it->report.instances++;
+            it->report.acquisitions += stats.acquisitions.load(std::memory_order_relaxed);
+            it->report.contended += stats.contended.load(std::memory_order_relaxed);
+            stats.wait.merge_into(it->wait, it->report.wait_ns);
+            stats.hold.merge_into(it->hold, it->report.hold_ns);
+
+            auto add_caller = [&](uintptr_t site, const auto& slot) {
+                uint64_t contended = slot.contended.load(std::memory_order_relaxed);
+                if (contended == 0) return;
+                auto caller = std::find_if(it->callers.begin(), it->callers.end(),
+                                           [&](const auto& c) { return c.first == site; });
+                if (caller == it->callers.end()) {
+                    it->callers.emplace_back(site, LockCaller{});
+                    caller = it->callers.end() - 1;
+                }
+                caller->second.contended += contended;
+                caller->second.wait_ns += slot.wait_ns.load(std::memory_order_relaxed);
+            };
+            for (const auto& slot : stats.callers) add_caller(slot.site.load(std::memory_order_relaxed), slot);
+            add_caller(0, stats.other);
+        }
+    }
+
+    std::vector<LockReport> out;
+    for (Merged& m : merged) {
+        m.report.wait_p50_ns = LatencyHistogram::quantile(m.wait, 0.50);
+        m.report.wait_p99_ns = LatencyHistogram::quantile(m.wait, 0.99);
+        m.report.hold_p50_ns = LatencyHistogram::quantile(m.hold, 0.50);
+        m.report.hold_p99_ns = LatencyHistogram::quantile(m.hold, 0.99);
+        std::sort(m.callers.begin(), m.callers.end(),
+                  [](const auto& a, const auto& b) { return a.second.wait_ns > b.second.wait_ns; });
+        for (auto& caller : m.callers) {
+            caller.second.site = caller.first ? detail::describe_site(caller.first) : "(other)";
+            m.report.callers.push_back(std::move(caller.second));
+        }
+        out.push_back(std::move(m.report));
+    }
+    std::sort(out.begin(), out.end(), [](const LockReport& a, const LockReport& b) {
+        return a.wait_ns != b.wait_ns ? a.wait_ns > b.wait_ns : a.contended > b.contended;
+    });
+    if (out.size() > top) out.resize(top);
+    return out;
+}
+
+inline void reset_lock_stats() {
+    auto& registry = detail::lock_registry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    for (ProfiledMutex* lock : registry.locks) {
+        auto& stats = *lock->stats;
+        stats.acquisitions.store(0, std::memory_order_relaxed);
+        stats.contended.store(0, std::memory_order_relaxed);
+        stats.wait.reset();
+        stats.hold.reset();
+        for (auto& slot : stats.callers) {
+            slot.site.store(0, std::memory_order_relaxed);
+            slot.contended.store(0, std::memory_order_relaxed);
+            slot.wait_ns.store(0, std::memory_order_relaxed);
+        }
+        stats.other.contended.store(0, std::memory_order_relaxed);
+        stats.other.wait_ns.store(0, std::memory_order_relaxed);
+    }
+}
+
+#else
+
+class ProfiledMutex {
+private:
+    std::mutex mutex;
+
+public:
+    explicit ProfiledMutex(const char* = "unnamed") {}
+    ProfiledMutex(const ProfiledMutex&) = delete;
+    ProfiledMutex& operator=(const ProfiledMutex&) = delete;
+
+    void lock() { mutex.lock(); }
+    bool try_lock() { return mutex.try_lock(); }
+    void unlock() { mutex.unlock(); }
+};
+
+inline std::vector<LockReport> lock_report(size_t = 10) { return {}; }
+inline void reset_lock_stats() {}
+
+#endif // QORACLE_LOCK_PROFILING
+
+// One line per lock, callers indented beneath
+inline std::string format_lock_report(const std::vector<LockReport>& report, size_t callers_per_lock = 3) {
+    std::string out;
+    for (const LockReport& lock : report) {
+        out += lock.name + " x" + std::to_string(lock.instances) +
+               ": acquired " + std::to_string(lock.acquisitions) +
+               ", contended " + std::to_string(lock.contended) +
+               ", wait " + std::to_string(lock.wait_ns / 1000) + "us (p50 " + std::to_string(lock.wait_p50_ns) +
+               "ns, p99 " + std::to_string(lock.wait_p99_ns) + "ns)" +
+               ", hold " + std::to_string(lock.hold_ns / 1000) + "us (p50 " + std::to_string(lock.hold_p50_ns) +
+               "ns, p99 " + std::to_string(lock.hold_p99_ns) + "ns)\n";
+        for (size_t i = 0; i < lock.callers.size() && i < callers_per_lock; ++i) {
+            out += "    " + lock.callers[i].site + ": contended " + std::to_string(lock.callers[i].contended) +
+                   ", wait " + std::to_string(lock.callers[i].wait_ns / 1000) + "us\n";
+        }
+    }
+    return out;
+}
+
+} // namespace qOracle
+
+#endif // PROFILED_MUTEX_HPP
@@ -17,8 +17,10 @@
 #include <string>
 #include <cstring>
 #include <stdexcept>
+#include <memory>
 #include <openssl/sha.h>
 #include <openssl/evp.h>
+#include "FixedPoint.hpp"
 
 namespace qOracle {
 
@@ -44,6 +46,8 @@ struct OracleIdentity {
     std::string address;
     bool active;
     
+    OracleIdentity() : index(0), active(false) { public_key.fill(0); }
+    
     OracleIdentity(size_t idx, const Dilithium3PubKey& pk, const std::string& addr)
         : index(idx), public_key(pk), address(addr), active(true) {}
 };
@@ -56,6 +60,8 @@ struct PriceMessage {
     uint64_t nonce;          // Anti-replay nonce
     std::string asset;       // Asset identifier (e.g., "BTC", "ETH")
     
+    PriceMessage() : price(0), timestamp(0), decimals(0), nonce(0) {}
+    
     PriceMessage(uint64_t p, uint64_t ts, uint8_t dec, uint64_t n, const std::string& a)
         : price(p), timestamp(ts), decimals(dec), nonce(n), asset(a) {}
     
@@ -128,6 +134,44 @@ struct PriceUpdate {
     bool has_quorum() const { return signatures.size() >= QUORUM_THRESHOLD; }
 };
 
+// Proof that a PriceUpdate met quorum. Only a verifier can issue one,
+// and copies share one immutable record, so passing a VerifiedPrice down
+// a call chain costs a reference count rather than the signature blobs.
+class VerifiedPrice {
+public:
+    struct Attestation {
+        PriceMessage message;
+        std::array<uint8_t, 32> digest;     // message.hash() the signatures covered
+        uint32_t signer_mask;               // Bit i set if oracle i signed validly
+        size_t signers;
+        const void* issuer;                 // Verifier that checked the signatures
+    };
+
+    VerifiedPrice() = default;
+
+    // False for a default-constructed handle or a failed verification
+    bool valid() const { return record != nullptr; }
+    explicit operator bool() const { return valid(); }
+
+    const PriceMessage& message() const { return record->message; }
+    uint64_t price() const { return record->message.price; }
+    uint64_t timestamp() const { return record->message.timestamp; }
+    uint64_t nonce() const { return record->message.nonce; }
+    const std::array<uint8_t, 32>& digest() const { return record->digest; }
+    uint32_t signer_mask() const { return record->signer_mask; }
+    size_t signers() const { return record->signers; }
+    const void* issuer() const { return record->issuer; }
+
+    // True if both handles refer to the same attestation
+    bool same_as(const VerifiedPrice& other) const { return record == other.record; }
+
+private:
+    friend class QuantumSignatureVerifier;
+    std::shared_ptr<const Attestation> record;
+
+    explicit VerifiedPrice(std::shared_ptr<const Attestation> r) : record(std::move(r)) {}
+};
+
 // Quantum-Resistant Signature Verifier
 class QuantumSignatureVerifier {
 private:
@@ -191,24 +235,34 @@ public:
                                          message_vec, sig.signature);
     }
     
-    // Verify price update with multiple signatures
-    bool verify_price_update(const PriceUpdate& update) const {
-        if (!update.has_quorum()) return false;
-        
-        // Check for duplicate signers
-        std::set<size_t> seen_oracles;
-        size_t valid_signatures = 0;
-        
+    // Bitmask of distinct oracles whose signatures on the update verify
+    uint32_t verified_signers(const PriceUpdate& update) const {
+        uint32_t mask = 0;
         for (const auto& sig : update.signatures) {
             if (sig.oracle_index >= NUM_ORACLES) continue;
-            if (!seen_oracles.insert(sig.oracle_index).second) continue; // Skip duplicates
+            if (mask & (1u << sig.oracle_index)) continue; // Skip duplicates
             
             if (verify_oracle_signature(sig, update.message)) {
-                ++valid_signatures;
+                mask |= 1u << sig.oracle_index;
             }
         }
-        
-        return valid_signatures >= QUORUM_THRESHOLD;
+        return mask;
+    }
+    
+    // Verify price update with multiple signatures
+    bool verify_price_update(const PriceUpdate& update) const {
+        if (!update.has_quorum()) return false;
+        return static_cast<size_t>(__builtin_popcount(verified_signers(update))) >= QUORUM_THRESHOLD;
+    }
+    
+    // Verify once and issue a shareable attestation; empty if quorum is not met
+    VerifiedPrice attest_price_update(const PriceUpdate& update) const {
+        if (!update.has_quorum()) return VerifiedPrice();
+        uint32_t mask = verified_signers(update);
+        size_t signers = static_cast<size_t>(__builtin_popcount(mask));
+        if (signers < QUORUM_THRESHOLD) return VerifiedPrice();
+        return VerifiedPrice(std::make_shared<const VerifiedPrice::Attestation>(
+            VerifiedPrice::Attestation{update.message, update.message.hash(), mask, signers, this}));
     }
     
     // Generate a new nonce for price updates
@@ -289,12 +343,9 @@ public:
     bool validate_price_deviation(uint64_t new_price, uint64_t old_price) const {
         if (old_price == 0) return true; // First price update
         
+        uint64_t change = new_price > old_price ? new_price - old_price : old_price - new_price;
         uint64_t deviation;
-        if (new_price > old_price) {
-            deviation = ((new_price - old_price) * 100) / old_price;
-        } else {
-            deviation = ((old_price - new_price) * 100) / old_price;
-        }
+        if (!mul_div(change, 100, old_price, deviation)) return false;
         
         return deviation <= max_deviation_percent;
     }
@@ -0,0 +1,116 @@
+/*
+ * Sharded Counter for qOracle
+ * Supply totals that many threads adjust without sharing a cache line
+ *
+ * A single atomic counter bumped by every mint and burn makes all cores
+ * take turns owning the same cache line. ShardedCounter spreads the
+ * updates over CELLS padded cells; each thread is assigned a cell on
+ * first use and only ever writes that one, so concurrent writers on
+ * different cells never contend.
+ *
+ * Each cell keeps two running totals, added and removed, that only move
+ * forward modulo 2^64; lifetime mints of a 15-decimal token pass 2^64
+ * after about 18,446 whole tokens, however small the supply stays. The
+ * value is their difference, also modulo 2^64, which is exact as long as
+ * the value itself fits in 64 bits. Reads collect every removed total
+ * before any added total, so a burn they see always comes with the mint
+ * that funded it and the difference never dips below zero.
+ *
+ * - load() sums the cells in one pass. It is exact once writers
+ *   quiesce; under load it may lag.
+ *
+ * - load_exact() collects every cell twice and retries until both passes
+ *   agree. The totals only move forward, so short of a cell moving by a
+ *   full 2^64 between passes, agreement means the counter really held
+ *   that value at one instant between them. Writers never wait, so a
+ *   reader racing a steady stream of them could retry forever; after
+ *   EXACT_RETRIES disagreeing passes it settles for the last pass, which
+ *   is no worse than load().
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef SHARDED_COUNTER_HPP
+#define SHARDED_COUNTER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include "BalanceTable.hpp"
+
+namespace qOracle {
+
+class ShardedCounter {
+public:
+    static constexpr size_t CELLS = 16;
+    static constexpr size_t EXACT_RETRIES = 64;
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Cell {
+        std::atomic<uint64_t> added{0};
+        std::atomic<uint64_t> removed{0};
+    };
+
+    std::array<Cell, CELLS> cells;
+
+    // Threads take cells round-robin in the order they first write
+    static size_t cell_index() {
+        static std::atomic<size_t> next_cell{0};
+        thread_local size_t index = next_cell.fetch_add(1, std::memory_order_relaxed) % CELLS;
+        return index;
+    }
+
+    struct Totals {
+        uint64_t added = 0;
+        uint64_t removed = 0;
+        bool operator==(const Totals& other) const { return added == other.added && removed == other.removed; }
+    };
+
+    void collect(std::array<Totals, CELLS>& out) const {
+        for (size_t i = 0; i < CELLS; ++i) out[i].removed = cells[i].removed.load();
+        for (size_t i = 0; i < CELLS; ++i) out[i].added = cells[i].added.load();
+    }
+
+public:
+    ShardedCounter() = default;
+    ShardedCounter(const ShardedCounter&) = delete;
+    ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+    void add(uint64_t amount) {
+        cells[cell_index()].added.fetch_add(amount);
+    }
+
+    void sub(uint64_t amount) {
+        cells[cell_index()].removed.fetch_add(amount);
+    }
+
+    // Cheap aggregate; exact when no writer is active
+    uint64_t load() const {
+        uint64_t added = 0, removed = 0;
+        for (const Cell& cell : cells) removed += cell.removed.load(std::memory_order_acquire);
+        for (const Cell& cell : cells) added += cell.added.load(std::memory_order_relaxed);
+        return added - removed;
+    }
+
+    // A value the counter held at one instant during the call, unless
+    // writers kept every pass from agreeing (see EXACT_RETRIES)
+    uint64_t load_exact() const {
+        std::array<Totals, CELLS> first, second;
+        collect(first);
+        for (size_t retry = 0; retry < EXACT_RETRIES; ++retry) {
+            collect(second);
+            if (first == second) break;
+            first = second;
+        }
+        uint64_t total = 0;
+        for (const Totals& cell : first) total += cell.added - cell.removed;
+        return total;
+    }
+
+    size_t memory_bytes() const { return sizeof(cells); }
+};
+
+} // namespace qOracle
+
+#endif // SHARDED_COUNTER_HPP
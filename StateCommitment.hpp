@@ -0,0 +1,202 @@
+/*
+ * Sparse Merkle State Commitment for qOracle Token Ledgers
+ * Authenticated map from AccountId to balance
+ *
+ * The tree has one leaf position per possible AccountId (depth 32). A
+ * zero balance is an empty leaf, and any subtree holding only empty
+ * leaves hashes to a precomputed default, so only paths to funded
+ * accounts are stored. Updating an account rehashes the 32 nodes on its
+ * path; a batch rehashes each affected level once, in parallel when a
+ * worker pool is supplied.
+ *
+ *   leaf     = SHA256(0x00 || id (4 bytes BE) || balance (8 bytes BE))
+ *   interior = SHA256(0x01 || left || right)
+ *
+ * Replicas holding equal balances agree on root() regardless of the
+ * order the updates were applied in.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef STATE_COMMITMENT_HPP
+#define STATE_COMMITMENT_HPP
+
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <mutex>
+#include <string>
+#include <algorithm>
+#include <openssl/sha.h>
+#include "AddressRegistry.hpp"
+#include "FlatHashMap.hpp"
+#include "WorkerPool.hpp"
+
+namespace qOracle {
+
+using StateHash = std::array<uint8_t, 32>;
+
+inline std::string to_hex(const StateHash& hash) {
+    static const char* DIGITS = "0123456789abcdef";
+    std::string out;
+    out.reserve(hash.size() * 2);
+    for (uint8_t byte : hash) {
+        out.push_back(DIGITS[byte >> 4]);
+        out.push_back(DIGITS[byte & 0xF]);
+    }
+    return out;
+}
+
+// Proof that account holds balance under a given root
+struct InclusionProof {
+    AccountId account = INVALID_ACCOUNT;
+    uint64_t balance = 0;
+    std::array<StateHash, 32> siblings;     // siblings[0] is the leaf's sibling
+};
+
+class SparseMerkleTree {
+public:
+    static constexpr size_t DEPTH = 32;
+
+private:
+    static constexpr size_t PARALLEL_THRESHOLD = 256;  // Nodes per level before using the pool
+
+    // levels[h] holds non-default nodes at height h keyed by id >> h;
+    // levels[DEPTH] holds the root under key 0
+    std::array<FlatHashMap<uint64_t, StateHash>, DEPTH + 1> levels;
+    std::array<StateHash, DEPTH + 1> defaults;
+    FlatHashMap<uint64_t, uint64_t> committed;          // Non-zero leaf balances, for proofs
+    mutable std::mutex tree_mutex;
+
+    static StateHash hash_leaf(AccountId id, uint64_t balance) {
+        uint8_t buf[13];
+        buf[0] = 0x00;
+        for (int i = 0; i < 4; ++i) buf[1 + i] = static_cast<uint8_t>(id >> (24 - 8 * i));
+        for (int i = 0; i < 8; ++i) buf[5 + i] = static_cast<uint8_t>(balance >> (56 - 8 * i));
+        StateHash out;
+        SHA256(buf, sizeof(buf), out.data());
+        return out;
+    }
+
+    static StateHash hash_node(const StateHash& left, const StateHash& right) {
+        uint8_t buf[65];
+        buf[0] = 0x01;
+        std::copy(left.begin(), left.end(), buf + 1);
+        std::copy(right.begin(), right.end(), buf + 33);
+        StateHash out;
+        SHA256(buf, sizeof(buf), out.data());
+        return out;
+    }
+
+    const StateHash& node(size_t height, uint64_t key) const {
+        auto it = levels[height].find(key);
+        return it != levels[height].end() ? it->second : defaults[height];
+    }
+
+    void store(size_t height, uint64_t key, const StateHash& hash) {
+        if (hash == defaults[height]) levels[height].erase(key);
+        else levels[height].insert_or_assign(key, hash);
+    }
+
+public:
+    SparseMerkleTree() {
+        defaults[0] = StateHash{};
+        for (size_t h = 1; h <= DEPTH; ++h) defaults[h] = hash_node(defaults[h - 1], defaults[h - 1]);
+    }
+
+    SparseMerkleTree(const SparseMerkleTree&) = delete;
+    SparseMerkleTree& operator=(const SparseMerkleTree&) = delete;
+
+    // Apply new balances for a set of accounts and rehash their paths.
+    // Interior levels with enough dirty nodes are hashed across the pool.
+    void update(const std::vector<std::pair<AccountId, uint64_t>>& changes, WorkerPool* pool = nullptr) {
+        if (changes.empty()) return;
+        std::lock_guard<std::mutex> lock(tree_mutex);
+
+        std::vector<uint64_t> dirty;
+        dirty.reserve(changes.size());
+        for (const auto& change : changes) {
+            if (change.second) {
+                store(0, change.first, hash_leaf(change.first, change.second));
+                committed.insert_or_assign(change.first, change.second);
+            } else {
+                store(0, change.first, defaults[0]);
+                committed.erase(change.first);
+            }
+            dirty.push_back(change.first >> 1);
+        }
+
+        std::vector<StateHash> hashes;
+        for (size_t h = 1; h <= DEPTH; ++h) {
+            std::sort(dirty.begin(), dirty.end());
+            dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+            // Children are read-only while a level is hashed; stores follow
+            hashes.resize(dirty.size());
+            auto rehash = [&](size_t i) {
+                hashes[i] = hash_node(node(h - 1, dirty[i] << 1), node(h - 1, (dirty[i] << 1) | 1));
+            };
+            if (pool && dirty.size() >= PARALLEL_THRESHOLD) {
+                pool->parallel_for(dirty.size(), rehash);
+            } else {
+                for (size_t i = 0; i < dirty.size(); ++i) rehash(i);
+            }
+
+            for (size_t i = 0; i < dirty.size(); ++i) {
+                store(h, dirty[i], hashes[i]);
+                dirty[i] >>= 1;
+            }
+        }
+    }
+
+    void update(AccountId id, uint64_t balance) {
+        update({{id, balance}});
+    }
+
+    StateHash root() const {
+        std::lock_guard<std::mutex> lock(tree_mutex);
+        return node(DEPTH, 0);
+    }
+
+    // Proves the balance as of the last update(), not the live ledger;
+    // an unfunded account proves a zero balance
+    InclusionProof prove(AccountId id) const {
+        std::lock_guard<std::mutex> lock(tree_mutex);
+        InclusionProof proof;
+        proof.account = id;
+        auto it = committed.find(id);
+        proof.balance = it != committed.end() ? it->second : 0;
+        for (size_t h = 0; h < DEPTH; ++h) {
+            proof.siblings[h] = node(h, (uint64_t(id) >> h) ^ 1);
+        }
+        return proof;
+    }
+
+    static bool verify(const StateHash& root, const InclusionProof& proof) {
+        StateHash hash = proof.balance ? hash_leaf(proof.account, proof.balance) : StateHash{};
+        for (size_t h = 0; h < DEPTH; ++h) {
+            hash = (proof.account >> h) & 1 ? hash_node(proof.siblings[h], hash)
+                                             : hash_node(hash, proof.siblings[h]);
+        }
+        return hash == root;
+    }
+
+    // Stored (non-default) nodes across all levels
+    size_t node_count() const {
+        std::lock_guard<std::mutex> lock(tree_mutex);
+        size_t count = 0;
+        for (const auto& level : levels) count += level.size();
+        return count;
+    }
+
+    size_t memory_bytes() const {
+        std::lock_guard<std::mutex> lock(tree_mutex);
+        size_t bytes = 0;
+        for (const auto& level : levels) bytes += level.memory_bytes();
+        return bytes + committed.memory_bytes();
+    }
+};
+
+} // namespace qOracle
+
+#endif // STATE_COMMITMENT_HPP
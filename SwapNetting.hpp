@@ -0,0 +1,154 @@
+/*
+ * Swap Netting Book for the qOracle Bridge
+ * Gathers swap requests for one settlement epoch, netted per account
+ *
+ * Requests are folded into a single entry per account as they arrive:
+ * the STX deposited for qBTC and the qBTC returned for STX, each summed
+ * per direction. The bridge later drains the book with take() and
+ * settles every account once, at one price, so a burst of N swaps from
+ * M accounts costs M ledger transactions instead of N.
+ *
+ * Volume limits are charged when a request is queued, not when it
+ * settles: each entry carries the bridge-wide reservations made for it
+ * (merged per limiter bucket) so a request dropped at settlement can hand
+ * its volume back.
+ *
+ * Entries are striped by account like the balance tables, so concurrent
+ * submitters only contend when their accounts share a stripe.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef SWAP_NETTING_HPP
+#define SWAP_NETTING_HPP
+
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <limits>
+#include <utility>
+#include "AddressRegistry.hpp"
+#include "BalanceTable.hpp"
+#include "FlatHashMap.hpp"
+#include "ProfiledMutex.hpp"
+#include "VolumeLimiter.hpp"
+
+namespace qOracle {
+
+// Everything one account asked for during an epoch
+struct NettedSwap {
+    uint64_t stx_in = 0;            // STX deposited for qBTC
+    uint64_t qbtc_in = 0;           // qBTC returned for STX
+    uint32_t stx_swaps = 0;
+    uint32_t qbtc_swaps = 0;
+    uint64_t stx_volume = 0;        // Volume reserved for the STX deposits
+    uint64_t qbtc_volume = 0;       // Volume reserved for the qBTC returns, at their quoted prices
+    std::vector<VolumeLimiter::Reservation> reservations;      // Bridge-wide holds, one per bucket
+
+    // Keep a granted reservation with the entry; same-bucket holds merge
+    void hold(const VolumeLimiter::Reservation& r) {
+        if (!r) return;
+        if (!reservations.empty() && reservations.back().bucket == r.bucket) reservations.back().amount += r.amount;
+        else reservations.push_back(r);
+    }
+};
+
+class SwapNettingBook {
+private:
+    struct alignas(CACHE_LINE_SIZE) Stripe {
+        ProfiledMutex mutex{"swap_netting.stripe"};
+        FlatHashMap<AccountId, NettedSwap> entries;
+    };
+
+    std::array<Stripe, BalanceTable::NUM_SHARDS> stripes;
+    std::atomic<uint64_t> epoch{1};
+    std::atomic<uint64_t> opened_at{0};     // First request of the open epoch, 0 while empty
+    std::atomic<size_t> requests{0};
+
+    Stripe& stripe_of(AccountId id) { return stripes[BalanceTable::shard_of(id)]; }
+
+    static bool add(uint64_t& total, uint64_t amount) {
+        if (amount > std::numeric_limits<uint64_t>::max() - total) return false;
+        total += amount;
+        return true;
+    }
+
+    void note_request(uint64_t now) {
+        uint64_t empty = 0;
+        opened_at.compare_exchange_strong(empty, now);
+        requests.fetch_add(1, std::memory_order_relaxed);
+    }
+
+public:
+    SwapNettingBook() = default;
+    SwapNettingBook(const SwapNettingBook&) = delete;
+    SwapNettingBook& operator=(const SwapNettingBook&) = delete;
+
+    // volume is the reservation the caller made for this request; it is
+    // kept only if the request is accepted
+    bool add_stx(AccountId id, uint64_t amount, uint64_t now, const VolumeLimiter::Reservation& volume = {}) {
+        if (id == INVALID_ACCOUNT || amount == 0) return false;
+        Stripe& stripe = stripe_of(id);
+        {
+            std::lock_guard<ProfiledMutex> lock(stripe.mutex);
+            NettedSwap& entry = stripe.entries[id];
+            if (!add(entry.stx_in, amount)) return false;
+            entry.stx_swaps++;
+            entry.stx_volume += volume.amount;
+            entry.hold(volume);
+        }
+        note_request(now);
+        return true;
+    }
+
+    // Queue a qBTC return only while the account's queued returns stay
+    // within available; a drained account cannot over-commit the epoch
+    bool add_qbtc(AccountId id, uint64_t amount, uint64_t available, uint64_t now,
+                  const VolumeLimiter::Reservation& volume = {}) {
+        if (id == INVALID_ACCOUNT || amount == 0) return false;
+        Stripe& stripe = stripe_of(id);
+        {
+            std::lock_guard<ProfiledMutex> lock(stripe.mutex);
+            NettedSwap& entry = stripe.entries[id];
+            if (entry.qbtc_in > available || amount > available - entry.qbtc_in) return false;
+            entry.qbtc_in += amount;
+            entry.qbtc_swaps++;
+            entry.qbtc_volume += volume.amount;
+            entry.hold(volume);
+        }
+        note_request(now);
+        return true;
+    }
+
+    // Drain the open epoch and start the next; entries are in no particular order
+    std::vector<std::pair<AccountId, NettedSwap>> take(uint64_t& closed_epoch) {
+        // Reset first: a request racing the drain then reopens the next
+        // epoch even if its entry lands in this one
+        closed_epoch = epoch.fetch_add(1);
+        opened_at.store(0);
+        requests.store(0, std::memory_order_relaxed);
+
+        std::vector<std::pair<AccountId, NettedSwap>> out;
+        for (Stripe& stripe : stripes) {
+            std::lock_guard<ProfiledMutex> lock(stripe.mutex);
+            for (const auto& entry : stripe.entries) out.push_back(entry);
+            stripe.entries.clear();
+        }
+        return out;
+    }
+
+    // True once the open epoch holds requests at least period seconds old
+    bool due(uint64_t now, uint64_t period) const {
+        uint64_t opened = opened_at.load();
+        return opened != 0 && now >= opened + period;
+    }
+
+    uint64_t current_epoch() const { return epoch.load(); }
+    size_t pending_requests() const { return requests.load(std::memory_order_relaxed); }
+};
+
+} // namespace qOracle
+
+#endif // SWAP_NETTING_HPP
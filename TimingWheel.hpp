@@ -0,0 +1,197 @@
+/*
+ * Hierarchical Timing Wheel for qOracle
+ * O(1) scheduling and cancellation of deadline timers
+ *
+ * Four wheels of 64 slots cover 2^24 ticks (about 194 days at one tick
+ * per second); later deadlines wait on an overflow list. A timer sits in
+ * the lowest wheel whose span still contains its deadline, and when a
+ * higher wheel's slot comes due its timers cascade down, each falling at
+ * most three times before it fires exactly on its tick. A 64-bit
+ * occupancy word per wheel lets advance() jump straight to the next
+ * occupied slot, so idle stretches cost one step per 64 ticks.
+ *
+ * Timers live in one pooled array linked through 32-bit indices. A
+ * handle carries a generation, so cancelling a timer that already fired
+ * is a harmless no-op. The wheel is not synchronized; its owner locks.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef TIMING_WHEEL_HPP
+#define TIMING_WHEEL_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+
+namespace qOracle {
+
+class TimingWheel {
+public:
+    using Handle = uint64_t;
+    static constexpr Handle NO_TIMER = 0;
+
+private:
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr unsigned SLOTS = 1u << SLOT_BITS;
+    static constexpr unsigned LEVELS = 4;
+    static constexpr unsigned SPAN_BITS = SLOT_BITS * LEVELS;
+    static constexpr unsigned OVERFLOW_LIST = LEVELS * SLOTS;   // Beyond the top wheel
+    static constexpr unsigned DUE_LIST = OVERFLOW_LIST + 1;     // Deadline already reached
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Timer {
+        uint64_t deadline;
+        uint64_t id;
+        uint32_t next;
+        uint32_t prev;
+        uint32_t generation;                // Odd while scheduled
+        uint32_t list;
+    };
+
+    std::vector<Timer> timers;
+    std::vector<uint32_t> free_timers;
+    std::array<uint32_t, DUE_LIST + 1> heads;
+    std::array<uint64_t, LEVELS> occupied{};
+    uint64_t current;
+    size_t pending = 0;
+
+    void link(uint32_t index, uint32_t list) {
+        Timer& t = timers[index];
+        t.list = list;
+        t.prev = NIL;
+        t.next = heads[list];
+        if (t.next != NIL) timers[t.next].prev = index;
+        heads[list] = index;
+        if (list < OVERFLOW_LIST) occupied[list / SLOTS] |= uint64_t(1) << (list % SLOTS);
+    }
+
+    void unlink(uint32_t index) {
+        Timer& t = timers[index];
+        if (t.prev != NIL) timers[t.prev].next = t.next;
+        else heads[t.list] = t.next;
+        if (t.next != NIL) timers[t.next].prev = t.prev;
+        if (t.list < OVERFLOW_LIST && heads[t.list] == NIL) {
+            occupied[t.list / SLOTS] &= ~(uint64_t(1) << (t.list % SLOTS));
+        }
+    }
+
+    // List for a deadline relative to the current tick
+    uint32_t list_for(uint64_t deadline) const {
+        if (deadline <= current) return DUE_LIST;
+        for (unsigned level = 0; level < LEVELS; ++level) {
+            unsigned shift = SLOT_BITS * (level + 1);
+            if ((deadline >> shift) == (current >> shift)) {
+                return level * SLOTS + static_cast<uint32_t>((deadline >> (SLOT_BITS * level)) & (SLOTS - 1));
+            }
+        }
+        return OVERFLOW_LIST;
+    }
+
+    // Re-place every timer on a list against the current tick
+    void cascade(uint32_t list) {
+        uint32_t index = heads[list];
+        heads[list] = NIL;
+        if (list < OVERFLOW_LIST) occupied[list / SLOTS] &= ~(uint64_t(1) << (list % SLOTS));
+        while (index != NIL) {
+            uint32_t next = timers[index].next;
+            link(index, list_for(timers[index].deadline));
+            index = next;
+        }
+    }
+
+    template <typename Fn>
+    size_t fire_list(uint32_t list, Fn& fire) {
+        size_t fired = 0;
+        while (heads[list] != NIL) {
+            uint32_t index = heads[list];
+            unlink(index);
+            Timer& t = timers[index];
+            uint64_t id = t.id, deadline = t.deadline;
+            t.generation++;
+            free_timers.push_back(index);
+            pending--;
+            fired++;
+            fire(id, deadline);                 // May schedule or cancel
+        }
+        return fired;
+    }
+
+public:
+    explicit TimingWheel(uint64_t start_tick = 0) : current(start_tick) { heads.fill(NIL); }
+
+    // Run fire(id) once the wheel reaches deadline (immediately on the next
+    // advance() if it already has)
+    Handle schedule(uint64_t deadline, uint64_t id) {
+        uint32_t index;
+        if (!free_timers.empty()) {
+            index = free_timers.back();
+            free_timers.pop_back();
+        } else {
+            index = static_cast<uint32_t>(timers.size());
+            timers.push_back(Timer{0, 0, NIL, NIL, 0, 0});
+        }
+        Timer& t = timers[index];
+        t.deadline = deadline;
+        t.id = id;
+        t.generation++;
+        link(index, list_for(deadline));
+        pending++;
+        return (uint64_t(t.generation) << 32) | index;
+    }
+
+    // False if the timer already fired or was cancelled
+    bool cancel(Handle handle) {
+        uint32_t index = static_cast<uint32_t>(handle);
+        uint32_t generation = static_cast<uint32_t>(handle >> 32);
+        if (index >= timers.size() || timers[index].generation != generation || !(generation & 1)) return false;
+        unlink(index);
+        timers[index].generation++;
+        free_timers.push_back(index);
+        pending--;
+        return true;
+    }
+
+    // Move the wheel to tick target, calling fire(id, deadline) for every
+    // timer due on the way; returns the count
+    template <typename Fn>
+    size_t advance(uint64_t target, Fn fire) {
+        size_t fired = fire_list(DUE_LIST, fire);
+        while (current < target) {
+            if (pending == 0) {
+                current = target;
+                break;
+            }
+            unsigned position = static_cast<unsigned>(current & (SLOTS - 1));
+            uint64_t ahead = position == SLOTS - 1 ? 0 : occupied[0] & (~uint64_t(0) << (position + 1));
+            uint64_t next = ahead ? (current & ~uint64_t(SLOTS - 1)) + static_cast<uint64_t>(__builtin_ctzll(ahead))
+                                  : (current | (SLOTS - 1)) + 1;
+            if (next > target) {
+                current = target;
+                break;
+            }
+            current = next;
+
+            // Crossing a wheel boundary pulls the next slot of each higher wheel down
+            if ((current & ((uint64_t(1) << SPAN_BITS) - 1)) == 0) cascade(OVERFLOW_LIST);
+            for (unsigned level = LEVELS - 1; level >= 1; --level) {
+                if ((current & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) != 0) continue;
+                cascade(level * SLOTS + static_cast<uint32_t>((current >> (SLOT_BITS * level)) & (SLOTS - 1)));
+            }
+            fired += fire_list(static_cast<uint32_t>(current & (SLOTS - 1)), fire);
+            fired += fire_list(DUE_LIST, fire);     // Timers scheduled by fire() for now
+        }
+        return fired;
+    }
+
+    uint64_t now() const { return current; }
+    size_t size() const { return pending; }
+    size_t memory_bytes() const {
+        return timers.capacity() * sizeof(Timer) + free_timers.capacity() * sizeof(uint32_t) + sizeof(heads);
+    }
+};
+
+} // namespace qOracle
+
+#endif // TIMING_WHEEL_HPP
@@ -0,0 +1,297 @@
+/*
+ * Sliding-Window Volume Limits for the qOracle Bridge
+ * Lock-free global limiter plus compact per-account limits
+ *
+ * VolumeLimiter splits its window into fixed buckets (1440 one-minute
+ * buckets for a day). Each bucket is one 64-bit word: the window cycle
+ * it belongs to in the top 14 bits and its volume in the low 50, so a
+ * bucket is claimed for a new minute and added to with a single CAS.
+ * A running total of live buckets is reserved with a CAS that refuses
+ * to pass the limit, so concurrent swaps can never overshoot it. As
+ * time moves on, the thread that advances the head retires the buckets
+ * that slid out of the window and subtracts them from the total. No
+ * interval can carry more than the limit plus one bucket's worth of
+ * slack, instead of twice the limit around a hard daily reset.
+ *
+ * AccountVolumeLimits bounds each account with a two-period estimate:
+ * the current period's volume plus the previous period's volume scaled
+ * by how much of it still overlaps the window. Entries are 24 bytes,
+ * striped by account and dropped once idle for two periods.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef VOLUME_LIMITER_HPP
+#define VOLUME_LIMITER_HPP
+
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include "AddressRegistry.hpp"
+#include "BalanceTable.hpp"
+#include "FlatHashMap.hpp"
+#include "ProfiledMutex.hpp"
+
+namespace qOracle {
+
+class VolumeLimiter {
+public:
+    static constexpr unsigned VOLUME_BITS = 50;
+    static constexpr uint64_t MAX_LIMIT = (uint64_t(1) << VOLUME_BITS) - 1;
+
+    // Proof of a successful reserve(), needed to hand the volume back
+    struct Reservation {
+        uint64_t bucket = 0;            // Absolute bucket number (now / bucket_seconds)
+        uint64_t amount = 0;
+        bool granted = false;
+        explicit operator bool() const { return granted; }
+    };
+
+private:
+    static constexpr unsigned CYCLE_BITS = 64 - VOLUME_BITS;
+    static constexpr uint64_t VOLUME_MASK = MAX_LIMIT;
+    static constexpr uint64_t CYCLE_MASK = (uint64_t(1) << CYCLE_BITS) - 1;
+
+    std::atomic<uint64_t> limit;
+    const uint64_t bucket_seconds;
+    const size_t bucket_count;
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> total{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head{0};     // Newest bucket number seen
+
+    uint64_t cycle_of(uint64_t bucket) const { return (bucket / bucket_count) & CYCLE_MASK; }
+    static uint64_t cycle_tag(uint64_t word) { return word >> VOLUME_BITS; }
+    static uint64_t volume(uint64_t word) { return word & VOLUME_MASK; }
+    static uint64_t pack(uint64_t cycle, uint64_t vol) { return (cycle << VOLUME_BITS) | vol; }
+
+    // True if cycle a is later than b, modulo tag wraparound
+    static bool newer(uint64_t a, uint64_t b) {
+        return a != b && ((a - b) & CYCLE_MASK) < (uint64_t(1) << (CYCLE_BITS - 1));
+    }
+
+    // Claim slot for absolute bucket number, retiring whatever older cycle held it
+    void retire_into(uint64_t bucket) {
+        std::atomic<uint64_t>& slot = buckets[bucket % bucket_count];
+        uint64_t cycle = cycle_of(bucket);
+        uint64_t word = slot.load(std::memory_order_acquire);
+        while (newer(cycle, cycle_tag(word))) {
+            if (slot.compare_exchange_weak(word, pack(cycle, 0), std::memory_order_acq_rel)) {
+                total.fetch_sub(volume(word), std::memory_order_acq_rel);
+                return;
+            }
+        }
+    }
+
+    void advance(uint64_t bucket) {
+        uint64_t seen = head.load(std::memory_order_acquire);
+        while (bucket > seen) {
+            if (head.compare_exchange_weak(seen, bucket, std::memory_order_acq_rel)) {
+                // Buckets (seen, bucket] reuse slots of buckets that just left the window
+                uint64_t first = bucket - seen > bucket_count ? bucket - bucket_count + 1 : seen + 1;
+                for (uint64_t b = first; b <= bucket; ++b) retire_into(b);
+                return;
+            }
+        }
+    }
+
+public:
+    VolumeLimiter(uint64_t max_volume, uint64_t window_seconds = 86400, uint64_t bucket_secs = 60)
+        : limit(max_volume), bucket_seconds(bucket_secs), bucket_count(window_seconds / bucket_secs),
+          buckets(new std::atomic<uint64_t>[window_seconds / bucket_secs]()) {
+        if (max_volume > MAX_LIMIT) throw std::invalid_argument("Volume limit exceeds 50-bit bucket capacity");
+        if (bucket_secs == 0 || bucket_count == 0) throw std::invalid_argument("Window must hold at least one bucket");
+    }
+
+    VolumeLimiter(const VolumeLimiter&) = delete;
+    VolumeLimiter& operator=(const VolumeLimiter&) = delete;
+
+    // Reserve amount at time now (seconds); fails without side effects if
+    // the window would exceed the limit
+    Reservation reserve(uint64_t amount, uint64_t now) {
+        Reservation r;
+        uint64_t bucket = now / bucket_seconds;
+        advance(bucket);
+        uint64_t cap = limit.load(std::memory_order_relaxed);
+        if (amount == 0 || amount > cap) return r;
+
+        uint64_t current = total.load(std::memory_order_acquire);
+        do {
+            if (current + amount > cap) return r;
+        } while (!total.compare_exchange_weak(current, current + amount, std::memory_order_acq_rel));
+
+        std::atomic<uint64_t>& slot = buckets[bucket % bucket_count];
+        uint64_t cycle = cycle_of(bucket);
+        uint64_t word = slot.load(std::memory_order_acquire);
+        for (;;) {
+            uint64_t tag = cycle_tag(word);
+            if (newer(tag, cycle)) {
+                // The clock moved a full window past us; the volume is already expired
+                total.fetch_sub(amount, std::memory_order_acq_rel);
+                break;
+            }
+            uint64_t expired = tag == cycle ? 0 : volume(word);
+            uint64_t base = tag == cycle ? volume(word) : 0;
+            if (slot.compare_exchange_weak(word, pack(cycle, base + amount), std::memory_order_acq_rel)) {
+                if (expired) total.fetch_sub(expired, std::memory_order_acq_rel);
+                break;
+            }
+        }
+
+        r.bucket = bucket;
+        r.amount = amount;
+        r.granted = true;
+        return r;
+    }
+
+    // Hand back a reservation whose operation did not go through; a no-op
+    // once its bucket has left the window
+    void release(Reservation& r) {
+        if (!r.granted) return;
+        r.granted = false;
+        std::atomic<uint64_t>& slot = buckets[r.bucket % bucket_count];
+        uint64_t cycle = cycle_of(r.bucket);
+        uint64_t word = slot.load(std::memory_order_acquire);
+        do {
+            if (cycle_tag(word) != cycle || volume(word) < r.amount) return;
+        } while (!slot.compare_exchange_weak(word, pack(cycle, volume(word) - r.amount), std::memory_order_acq_rel));
+        total.fetch_sub(r.amount, std::memory_order_acq_rel);
+    }
+
+    // Volume inside the window ending at now
+    uint64_t used(uint64_t now) {
+        advance(now / bucket_seconds);
+        return total.load(std::memory_order_acquire);
+    }
+
+    // Lowering the limit below the volume in flight blocks new reserves
+    // until enough of it leaves the window
+    bool set_limit(uint64_t max_volume) {
+        if (max_volume > MAX_LIMIT) return false;
+        limit.store(max_volume, std::memory_order_relaxed);
+        return true;
+    }
+
+    uint64_t capacity() const { return limit.load(std::memory_order_relaxed); }
+    size_t memory_bytes() const { return bucket_count * sizeof(std::atomic<uint64_t>); }
+};
+
+class AccountVolumeLimits {
+private:
+    struct Window {
+        uint32_t period = 0;            // now / period_seconds of the current period
+        uint64_t current = 0;
+        uint64_t previous = 0;
+    };
+    static_assert(sizeof(Window) == 24, "Per-account window should stay compact (4 bytes of it are padding)");
+
+    struct alignas(CACHE_LINE_SIZE) Stripe {
+        ProfiledMutex mutex{"account_limits.stripe"};
+        FlatHashMap<AccountId, Window> windows;
+    };
+
+    std::atomic<uint64_t> limit;
+    const uint64_t period_seconds;
+    std::array<Stripe, BalanceTable::NUM_SHARDS> stripes;
+
+    Stripe& stripe_of(AccountId id) { return stripes[BalanceTable::shard_of(id)]; }
+
+    // Roll w forward to period, keeping the previous period only if adjacent
+    static void roll(Window& w, uint32_t period) {
+        if (w.period == period) return;
+        w.previous = (w.period + 1 == period) ? w.current : 0;
+        w.current = 0;
+        w.period = period;
+    }
+
+    uint64_t estimate(const Window& w, uint64_t now) const {
+        uint64_t elapsed = now % period_seconds;
+        // Share of the previous period still inside the sliding window
+        unsigned __int128 carried = static_cast<unsigned __int128>(w.previous) * (period_seconds - elapsed);
+        return w.current + static_cast<uint64_t>(carried / period_seconds);
+    }
+
+public:
+    AccountVolumeLimits(uint64_t max_volume, uint64_t window_seconds = 86400)
+        : limit(max_volume), period_seconds(window_seconds) {
+        if (window_seconds == 0) throw std::invalid_argument("Window must be non-empty");
+    }
+
+    bool reserve(AccountId id, uint64_t amount, uint64_t now) {
+        uint64_t cap = limit.load(std::memory_order_relaxed);
+        if (id == INVALID_ACCOUNT || amount > cap) return false;
+        uint32_t period = static_cast<uint32_t>(now / period_seconds);
+        Stripe& stripe = stripe_of(id);
+        std::lock_guard<ProfiledMutex> lock(stripe.mutex);
+        // A refused reserve must not leave an empty window behind
+        auto it = stripe.windows.find(id);
+        if (it == stripe.windows.end()) {
+            stripe.windows.emplace(id, Window{period, amount, 0});
+            return true;
+        }
+        Window& w = it->second;
+        roll(w, period);
+        if (estimate(w, now) + amount > cap) return false;
+        w.current += amount;
+        return true;
+    }
+
+    void release(AccountId id, uint64_t amount, uint64_t now) {
+        uint32_t period = static_cast<uint32_t>(now / period_seconds);
+        Stripe& stripe = stripe_of(id);
+        std::lock_guard<ProfiledMutex> lock(stripe.mutex);
+        auto it = stripe.windows.find(id);
+        if (it == stripe.windows.end()) return;
+        Window& w = it->second;
+        roll(w, period);
+        uint64_t& from = w.current >= amount ? w.current : w.previous;
+        from -= std::min(from, amount);
+    }
+
+    uint64_t used(AccountId id, uint64_t now) {
+        uint32_t period = static_cast<uint32_t>(now / period_seconds);
+        Stripe& stripe = stripe_of(id);
+        std::lock_guard<ProfiledMutex> lock(stripe.mutex);
+        auto it = stripe.windows.find(id);
+        if (it == stripe.windows.end()) return 0;
+        Window w = it->second;
+        roll(w, period);
+        return estimate(w, now);
+    }
+
+    // Forget accounts with nothing left in the window
+    size_t prune(uint64_t now) {
+        uint32_t period = static_cast<uint32_t>(now / period_seconds);
+        size_t dropped = 0;
+        for (Stripe& stripe : stripes) {
+            std::lock_guard<ProfiledMutex> lock(stripe.mutex);
+            std::vector<AccountId> idle;
+            for (const auto& entry : stripe.windows) {
+                if (entry.second.period + 1 < period) idle.push_back(entry.first);
+            }
+            for (AccountId id : idle) stripe.windows.erase(id);
+            dropped += idle.size();
+        }
+        return dropped;
+    }
+
+    void set_limit(uint64_t max_volume) { limit.store(max_volume, std::memory_order_relaxed); }
+    uint64_t capacity() const { return limit.load(std::memory_order_relaxed); }
+
+    size_t tracked_accounts() {
+        size_t count = 0;
+        for (Stripe& stripe : stripes) {
+            std::lock_guard<ProfiledMutex> lock(stripe.mutex);
+            count += stripe.windows.size();
+        }
+        return count;
+    }
+};
+
+} // namespace qOracle
+
+#endif // VOLUME_LIMITER_HPP
@@ -0,0 +1,106 @@
+/*
+ * Worker Pool for qOracle
+ * Fixed set of threads running parallel-for jobs
+ *
+ * Shared by the block executor and the state commitment; jobs from
+ * different callers run one after another.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <cstddef>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <functional>
+
+namespace qOracle {
+
+class WorkerPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex job_mutex;                   // One parallel_for at a time
+    std::mutex pool_mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+    std::function<void(size_t)> job;
+    std::atomic<size_t> next_index{0};
+    size_t job_size = 0;
+    size_t generation = 0;
+    size_t busy = 0;
+    bool stopping = false;
+
+    void drain() {
+        for (size_t i = next_index.fetch_add(1); i < job_size; i = next_index.fetch_add(1)) {
+            job(i);
+        }
+    }
+
+    void worker_loop() {
+        size_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(pool_mutex);
+                work_ready.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                ++busy;
+            }
+            drain();
+            {
+                std::lock_guard<std::mutex> lock(pool_mutex);
+                if (--busy == 0) work_done.notify_all();
+            }
+        }
+    }
+
+public:
+    explicit WorkerPool(size_t threads) {
+        for (size_t i = 1; i < threads; ++i) {     // The calling thread is worker 0
+            workers.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            stopping = true;
+        }
+        work_ready.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    size_t size() const { return workers.size() + 1; }
+
+    // Run fn(0..count-1) across the pool; returns when every call finished
+    void parallel_for(size_t count, std::function<void(size_t)> fn) {
+        if (count == 0) return;
+        std::lock_guard<std::mutex> serial(job_mutex);
+        {
+            // A worker that woke late for the previous job may still be draining it
+            std::unique_lock<std::mutex> lock(pool_mutex);
+            work_done.wait(lock, [&] { return busy == 0; });
+            job = std::move(fn);
+            job_size = count;
+            next_index.store(0);
+            ++generation;
+        }
+        work_ready.notify_all();
+        drain();
+
+        std::unique_lock<std::mutex> lock(pool_mutex);
+        work_done.wait(lock, [&] { return busy == 0; });
+    }
+};
+
+} // namespace qOracle
+
+#endif // WORKER_POOL_HPP
@@ -0,0 +1,902 @@
+/*
+ * qOracle Microbenchmarks
+ * Per-operation cost of the hot RC2 APIs, as machine-readable JSON
+ *
+ * Every benchmark reports ns/op, heap allocations/op and the p50, p90,
+ * p99 and p999 of its samples. Fast operations are timed in batches long
+ * enough to hide the clock read, so their percentiles are over batch
+ * means; slow ones are timed one by one. Allocations are counted by
+ * replacing the global operator new in this binary. Container benchmarks
+ * also report the heap bytes they hold per stored item.
+ *
+ * Build:  g++ -std=c++17 -O2 -o qOracle_Benchmarks qOracle_Benchmarks.cpp -lcrypto -lpthread
+ * Run:    ./run_benchmarks.sh [--quick] [--filter <substring>] [--out <file.json>]
+ *
+ * The system under test logs and records events like production, so it
+ * writes qoracle_production.log and qoracle_events/ in the working
+ * directory; run_benchmarks.sh runs it in a scratch directory.
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#define QORACLE_NO_MAIN
+#include "qOracle_Production_RC2.cpp"
+#include "OracleSimulator.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <unordered_set>
+
+// ========================== ALLOCATION COUNTING ==========================
+namespace bench {
+std::atomic<uint64_t> allocations{0};
+std::atomic<uint64_t> allocated_bytes{0};      // Requested sizes; frees are not subtracted
+}
+
+void* operator new(std::size_t size) {
+    bench::allocations.fetch_add(1, std::memory_order_relaxed);
+    bench::allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    bench::allocations.fetch_add(1, std::memory_order_relaxed);
+    bench::allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    size_t alignment = static_cast<size_t>(align);
+    size_t rounded = (size + alignment - 1) / alignment * alignment;
+    if (void* p = std::aligned_alloc(alignment, rounded ? rounded : alignment)) return p;
+    throw std::bad_alloc();
+}
+
+// Out of line so GCC does not pair the inlined free() with new
+// and report a mismatched deallocation
+__attribute__((noinline)) void operator delete(void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+// ========================== HARNESS ==========================
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    double min_seconds = 0.5;       // Per benchmark
+    bool quick = false;
+    std::string filter;
+    std::string out;
+};
+
+struct Result {
+    std::string name;
+    std::string params;
+    unsigned threads = 1;
+    uint64_t iterations = 0;
+    double ns_per_op = 0;
+    double allocs_per_op = 0;
+    double p50_ns = 0;
+    double p90_ns = 0;
+    double p99_ns = 0;
+    double p999_ns = 0;
+    double bytes_per_item = 0;      // Heap footprint per stored item, where measured
+};
+
+Options options;
+std::vector<Result> results;
+
+constexpr size_t MAX_SAMPLES = 1 << 18;
+constexpr double BATCH_NS = 2000;       // Shortest batch worth timing
+
+bool selected(const std::string& name) {
+    return options.filter.empty() || name.find(options.filter) != std::string::npos;
+}
+
+// Whether any benchmark named group... can match, to skip costly setup
+bool selected_group(const std::string& group) {
+    return options.filter.empty() || group.find(options.filter) != std::string::npos ||
+           options.filter.compare(0, group.size(), group) == 0;
+}
+
+double elapsed_ns(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double, std::nano>(to - from).count();
+}
+
+double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0;
+    size_t index = static_cast<size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+void record(Result result, std::vector<double>& samples) {
+    std::sort(samples.begin(), samples.end());
+    result.p50_ns = percentile(samples, 0.50);
+    result.p90_ns = percentile(samples, 0.90);
+    result.p99_ns = percentile(samples, 0.99);
+    result.p999_ns = percentile(samples, 0.999);
+    std::fprintf(stderr, "%-32s %-32s %2ut %10.1f ns/op %8.2f allocs/op  p50 %.0f  p99 %.0f  p999 %.0f\n",
+                 result.name.c_str(), result.params.c_str(), result.threads, result.ns_per_op, result.allocs_per_op,
+                 result.p50_ns, result.p99_ns, result.p999_ns);
+    results.push_back(std::move(result));
+}
+
+// Run op(i) for i = 0, 1, ... until min_seconds have passed or
+// max_iterations ran; each call counts as items operations
+template <typename Op>
+void run(const std::string& name, const std::string& params, Op&& op,
+         uint64_t max_iterations = ~uint64_t(0), uint64_t items = 1) {
+    if (!selected(name)) return;
+    uint64_t i = 0;
+
+    // Grow the batch until it is long enough to time
+    uint64_t batch = 1;
+    for (;;) {
+        auto start = Clock::now();
+        for (uint64_t b = 0; b < batch && i < max_iterations; ++b) op(i++);
+        if (elapsed_ns(start, Clock::now()) >= BATCH_NS || batch >= (1u << 16) || i >= max_iterations) break;
+        batch *= 2;
+    }
+
+    std::vector<double> samples;
+    samples.reserve(MAX_SAMPLES);
+    uint64_t measured = 0, allocs = 0;
+    double total_ns = 0;
+    while ((total_ns < options.min_seconds * 1e9 || samples.size() < 16) &&
+           samples.size() < MAX_SAMPLES && i < max_iterations) {
+        uint64_t count = std::min<uint64_t>(batch, max_iterations - i);
+        uint64_t allocs_before = allocations.load(std::memory_order_relaxed);
+        auto start = Clock::now();
+        for (uint64_t b = 0; b < count; ++b) op(i++);
+        double ns = elapsed_ns(start, Clock::now());
+        allocs += allocations.load(std::memory_order_relaxed) - allocs_before;
+        total_ns += ns;
+        measured += count;
+        samples.push_back(ns / static_cast<double>(count * items));
+    }
+    if (measured == 0) return;
+
+    Result result;
+    result.name = name;
+    result.params = params;
+    result.iterations = measured * items;
+    result.ns_per_op = total_ns / static_cast<double>(measured * items);
+    result.allocs_per_op = static_cast<double>(allocs) / static_cast<double>(measured * items);
+    record(std::move(result), samples);
+}
+
+// Like run(), but setup() runs untimed before each timed op()
+template <typename Setup, typename Op>
+void run_with_setup(const std::string& name, const std::string& params, Setup&& setup, Op&& op,
+                    uint64_t repetitions, uint64_t items = 1) {
+    if (!selected(name)) return;
+    std::vector<double> samples;
+    uint64_t allocs = 0, total_items = 0;
+    double total_ns = 0;
+    for (uint64_t r = 0; r < repetitions; ++r) {
+        uint64_t n = setup(r);
+        if (n == 0) n = items;
+        uint64_t allocs_before = allocations.load(std::memory_order_relaxed);
+        auto start = Clock::now();
+        op(r);
+        double ns = elapsed_ns(start, Clock::now());
+        allocs += allocations.load(std::memory_order_relaxed) - allocs_before;
+        total_ns += ns;
+        total_items += n;
+        samples.push_back(ns / static_cast<double>(n));
+    }
+    if (total_items == 0) return;
+
+    Result result;
+    result.name = name;
+    result.params = params;
+    result.iterations = total_items;
+    result.ns_per_op = total_ns / static_cast<double>(total_items);
+    result.allocs_per_op = static_cast<double>(allocs) / static_cast<double>(total_items);
+    record(std::move(result), samples);
+}
+
+// op(thread, i) from threads threads at once, ops_per_thread each.
+// ns/op is wall time over all operations, i.e. inverse throughput;
+// percentiles are over per-thread batches of BATCH operations.
+template <typename Op>
+void run_threads(const std::string& name, const std::string& params, unsigned threads,
+                 uint64_t ops_per_thread, Op&& op) {
+    if (!selected(name)) return;
+    constexpr uint64_t BATCH = 64;
+    std::vector<std::vector<double>> per_thread(threads);
+    std::atomic<unsigned> ready{0};
+    std::atomic<bool> go{false};
+
+    uint64_t allocs_before = allocations.load(std::memory_order_relaxed);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            per_thread[t].reserve(ops_per_thread / BATCH + 1);
+            ready.fetch_add(1);
+            while (!go.load()) std::this_thread::yield();
+            for (uint64_t i = 0; i < ops_per_thread;) {
+                uint64_t count = std::min(BATCH, ops_per_thread - i);
+                auto start = Clock::now();
+                for (uint64_t b = 0; b < count; ++b) op(t, i++);
+                per_thread[t].push_back(elapsed_ns(start, Clock::now()) / static_cast<double>(count));
+            }
+        });
+    }
+    while (ready.load() < threads) std::this_thread::yield();
+    auto start = Clock::now();
+    go.store(true);
+    for (auto& worker : workers) worker.join();
+    double wall_ns = elapsed_ns(start, Clock::now());
+    uint64_t allocs = allocations.load(std::memory_order_relaxed) - allocs_before;
+
+    std::vector<double> samples;
+    for (auto& thread_samples : per_thread) samples.insert(samples.end(), thread_samples.begin(), thread_samples.end());
+
+    Result result;
+    result.name = name;
+    result.params = params;
+    result.threads = threads;
+    result.iterations = ops_per_thread * threads;
+    result.ns_per_op = wall_ns / static_cast<double>(result.iterations);
+    result.allocs_per_op = static_cast<double>(allocs) / static_cast<double>(result.iterations);
+    record(std::move(result), samples);
+}
+
+std::string json_escape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+std::string to_json() {
+    char buffer[512];
+    std::string out = "{\n  \"suite\": \"qOracle microbenchmarks\",\n";
+    std::snprintf(buffer, sizeof(buffer), "  \"quick\": %s,\n  \"hardware_threads\": %u,\n  \"results\": [\n",
+                  options.quick ? "true" : "false", std::thread::hardware_concurrency());
+    out += buffer;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::snprintf(buffer, sizeof(buffer),
+                      "    {\"name\": \"%s\", \"params\": \"%s\", \"threads\": %u, \"iterations\": %llu, "
+                      "\"ns_per_op\": %.2f, \"allocs_per_op\": %.3f, \"p50_ns\": %.1f, \"p90_ns\": %.1f, "
+                      "\"p99_ns\": %.1f, \"p999_ns\": %.1f, \"bytes_per_item\": %.1f}%s\n",
+                      json_escape(r.name).c_str(), json_escape(r.params).c_str(), r.threads,
+                      static_cast<unsigned long long>(r.iterations), r.ns_per_op, r.allocs_per_op,
+                      r.p50_ns, r.p90_ns, r.p99_ns, r.p999_ns, r.bytes_per_item, i + 1 < results.size() ? "," : "");
+        out += buffer;
+    }
+    out += "  ]\n}\n";
+    return out;
+}
+
+// Attach a memory footprint to the benchmark just recorded
+void report_bytes(const std::string& name, uint64_t bytes, uint64_t items) {
+    if (results.empty() || results.back().name != name || items == 0) return;
+    results.back().bytes_per_item = static_cast<double>(bytes) / static_cast<double>(items);
+    std::fprintf(stderr, "%-32s %-32s     %10.1f bytes/item\n", "", "", results.back().bytes_per_item);
+}
+
+// Results the optimizer must not discard
+volatile uint64_t kept = 0;
+void keep(uint64_t value) { kept = value; }
+
+// Deterministic index stream
+struct XorShift {
+    uint64_t state;
+    explicit XorShift(uint64_t seed) : state(seed ? seed : 1) {}
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+uint64_t now_seconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace bench
+
+// ========================== FIXTURE ==========================
+namespace {
+
+const std::string DEPLOYER = "ST1SJ3DTE5DN7X54YDH5D64R3BCB6A2AG2ZQ8YPD5";
+constexpr uint64_t BENCH_PRICE = 1000000000000000ULL;      // 1.0 at 15 decimals
+constexpr uint64_t SWAP_AMOUNT = qOracleConfig::MIN_SWAP_AMOUNT;
+
+// A fully launched system fed by simulated oracles
+struct Fixture {
+    qOracle::OracleSimulator oracles;
+    QOracleSystem system;
+    qOracle::PriceUpdate update;
+
+    Fixture()
+        : system(DEPLOYER, oracles.public_keys(), oracles.oracle_addresses(), {DEPLOYER, "GOV_B", "GOV_C"}, DEPLOYER),
+          update(oracles.make_update(qOracle::PriceMessage(BENCH_PRICE, bench::now_seconds(), 15, 1, "BTC"))) {
+        system.initialize_system(DEPLOYER);
+        system.get_bridge()->set_daily_volume_limit(DEPLOYER, qOracle::VolumeLimiter::MAX_LIMIT);
+        system.get_bridge()->set_account_volume_limit(DEPLOYER, qOracle::VolumeLimiter::MAX_LIMIT);
+        if (!system.get_oracle_committee()->submit_price_update(update)) {
+            throw std::runtime_error("Simulated committee update rejected");
+        }
+    }
+
+    // Distinct funded BKPY accounts named prefix0, prefix1, ...
+    std::vector<qOracle::AccountId> fund_accounts(const std::string& prefix, size_t count, uint64_t amount) {
+        auto* registry = system.get_address_registry();
+        auto* token = system.get_bkpy_token();
+        qOracle::AccountId admin = registry->intern(DEPLOYER);
+        std::vector<qOracle::AccountId> ids;
+        ids.reserve(count);
+        std::vector<qOracle::TransferLeg> legs;
+        for (size_t i = 0; i < count; ++i) {
+            ids.push_back(registry->intern(prefix + std::to_string(i)));
+            legs.push_back({ids.back(), amount});
+            if (legs.size() == 4096 || i + 1 == count) {
+                token->transfer_batch(admin, legs);
+                legs.clear();
+            }
+        }
+        return ids;
+    }
+};
+
+// Governance clock the benchmarks move by hand
+std::atomic<uint64_t> governance_clock{0};
+uint64_t read_governance_clock() { return governance_clock.load(); }
+
+} // namespace
+
+// ========================== BENCHMARKS ==========================
+namespace {
+
+void bench_event_store() {
+    if (!bench::selected_group("event_store.")) return;
+    const uint64_t events = bench::options.quick ? 200000 : 2000000;
+    const size_t addresses = 10000;
+    std::vector<std::string> names;
+    for (size_t i = 0; i < addresses; ++i) names.push_back("EVENTADDR" + std::to_string(i));
+
+    std::filesystem::remove_all("qoracle_bench_events");
+    qOracle::EventStore store("qoracle_bench_events");
+    const uint64_t start_time = bench::now_seconds();
+    bench::XorShift rng(26);
+    uint64_t appended = 0;
+    bench::run("event_store.append", "addresses=10000", [&](uint64_t i) {
+        appended += store.append(qOracle::EventType::Transfer, start_time + i / 100, i & 1 ? "BKPY" : "qBTC",
+                                 names[rng.next() % addresses], names[rng.next() % addresses], i);
+    }, events);
+    for (uint64_t i = store.size(); i < events; ++i) {
+        store.append(qOracle::EventType::Transfer, start_time + i / 100, i & 1 ? "BKPY" : "qBTC",
+                     names[rng.next() % addresses], names[rng.next() % addresses], i);
+    }
+
+    // Indexed lookups against the scan the indexes replace
+    uint64_t found = 0;
+    uint64_t span = store.size() / 100;
+    qOracle::EventQuery by_address;
+    by_address.limit = 100;
+    bench::run("event_store.query_address", "events=" + std::to_string(store.size()) + ",limit=100", [&](uint64_t) {
+        by_address.address = names[rng.next() % addresses];
+        found += store.query(by_address).size();
+    });
+    qOracle::EventQuery window;
+    window.asset = "qBTC";
+    window.limit = 1000;
+    bench::run("event_store.query_time_window", "events=" + std::to_string(store.size()) + ",limit=1000", [&](uint64_t) {
+        window.since = start_time + rng.next() % (span ? span : 1);
+        found += store.query(window).size();
+    });
+    qOracle::EventQuery scan;
+    scan.types = qOracle::event_mask(qOracle::EventType::Swap);     // No index: every record is visited
+    bench::run("event_store.query_unindexed_scan", "events=" + std::to_string(store.size()), [&](uint64_t) {
+        found += store.query(scan).size() + 1;
+    }, bench::options.quick ? 20 : 50);
+    bench::keep(appended + found);
+    std::filesystem::remove_all("qoracle_bench_events");
+}
+
+void bench_price_messages(Fixture& fx) {
+    qOracle::PriceMessage message(BENCH_PRICE, bench::now_seconds(), 15, 42, "BTC");
+    uint64_t sink = 0;
+    bench::run("price_message.serialize", "", [&](uint64_t) { sink += message.serialize().size(); });
+    bench::run("price_message.hash", "", [&](uint64_t) { sink += message.hash()[0]; });
+
+    qOracle::QuantumSignatureVerifier verifier;
+    verifier.initialize_oracles(fx.oracles.public_keys(), fx.oracles.oracle_addresses());
+    for (size_t signers : {qOracleConfig::QUORUM_THRESHOLD, qOracleConfig::NUM_ORACLES}) {
+        qOracle::PriceUpdate update = fx.oracles.make_update(message, signers);
+        std::string params = "signatures=" + std::to_string(signers);
+        bench::run("verifier.verify_price_update", params, [&](uint64_t) { sink += verifier.verify_price_update(update); });
+        bench::run("verifier.attest_price_update", params, [&](uint64_t) {
+            sink += verifier.attest_price_update(update).signers();
+        });
+    }
+    bench::keep(sink);
+}
+
+void bench_committee(Fixture& fx) {
+    auto* committee = fx.system.get_oracle_committee();
+    uint64_t sink = 0;
+    bench::run("committee.submit_price_update", "signatures=7", [&](uint64_t) {
+        sink += committee->submit_price_update(fx.update);
+    });
+    bench::run("committee.get_current_price", "", [&](uint64_t) { sink += committee->get_current_price().price; });
+    bench::run("committee.verified_price", "", [&](uint64_t) { sink += committee->verified_price().price(); });
+    bench::keep(sink);
+}
+
+void bench_ledger(Fixture& fx) {
+    std::vector<size_t> sizes = {1000, 100000};
+    if (!bench::options.quick) sizes.push_back(1000000);
+
+    auto* token = fx.system.get_bkpy_token();
+    uint64_t sink = 0;
+    for (size_t accounts : sizes) {
+        std::string prefix = "BENCH" + std::to_string(accounts) + "_";
+        if (!bench::selected_group("bkpy.") && !bench::selected_group("merkle.")) continue;
+        std::vector<qOracle::AccountId> ids = fx.fund_accounts(prefix, accounts, 1000000000ULL);
+        std::vector<std::string> names;
+        names.reserve(accounts);
+        for (size_t i = 0; i < accounts; ++i) names.push_back(prefix + std::to_string(i));
+
+        std::string params = "accounts=" + std::to_string(accounts);
+        bench::XorShift rng(accounts);
+        bench::run("bkpy.transfer", params, [&](uint64_t) {
+            size_t from = rng.next() % accounts, to = rng.next() % accounts;
+            sink += token->transfer(names[from], names[to], 1);
+        });
+        bench::run("bkpy.transfer_id", params, [&](uint64_t) {
+            size_t from = rng.next() % accounts, to = rng.next() % accounts;
+            sink += token->transfer(ids[from], ids[to], 1);
+        });
+        bench::run("bkpy.balanceOf", params, [&](uint64_t) { sink += token->balanceOf(names[rng.next() % accounts]); });
+        bench::run("bkpy.balanceOf_id", params, [&](uint64_t) { sink += token->balanceOf(ids[rng.next() % accounts]); });
+
+        // Merkle commit cost per account changed since the last epoch
+        const size_t changes = 1000;
+        std::unordered_set<qOracle::AccountId> touched;
+        bench::run_with_setup("merkle.commit_epoch", params + ",transfers=" + std::to_string(changes),
+            [&](uint64_t) -> uint64_t {
+                token->commit_epoch();
+                touched.clear();
+                for (size_t t = 0; t < changes; ++t) {
+                    size_t from = rng.next() % accounts, to = rng.next() % accounts;
+                    token->transfer(ids[from], ids[to], 1);
+                    touched.insert(ids[from]);
+                    touched.insert(ids[to]);
+                }
+                return touched.size();
+            },
+            [&](uint64_t) { sink += token->commit_epoch(); },
+            bench::options.quick ? 5 : 20);
+    }
+    bench::keep(sink);
+}
+
+// Snapshot publish cost and the node memory each retention depth holds.
+// Every epoch changes 1000 random accounts, and enough epochs run that
+// the retention window is full before the footprint is read.
+void bench_snapshots() {
+    if (!bench::selected_group("snapshots.")) return;
+    const size_t accounts = 100000, changes = 1000;
+    for (size_t retention : {size_t(16), size_t(256)}) {
+        qOracle::BalanceSnapshots snapshots(retention);
+        std::vector<std::pair<qOracle::AccountId, uint64_t>> batch;
+        for (size_t id = 0; id < accounts; ++id) batch.push_back({static_cast<qOracle::AccountId>(id), 1000000});
+        snapshots.publish(batch);
+
+        bench::XorShift rng(retention);
+        std::string params = "accounts=100000,changes=1000,retention=" + std::to_string(retention);
+        bench::run_with_setup("snapshots.publish", params,
+            [&](uint64_t) -> uint64_t {
+                batch.clear();
+                for (size_t c = 0; c < changes; ++c) {
+                    batch.push_back({static_cast<qOracle::AccountId>(rng.next() % accounts), rng.next() % 1000000});
+                }
+                return batch.size();
+            },
+            [&](uint64_t) { snapshots.publish(batch); },
+            retention + (bench::options.quick ? 16 : 64));
+        bench::report_bytes("snapshots.publish", snapshots.memory_bytes(), accounts);
+    }
+}
+
+// Block execution across conflict rates: each transfer of a block
+// comes from one hot sender with probability conflict%, otherwise
+// between random accounts. At 100% the block is a single dependency
+// chain; the same block is also run with speculation only (no serial
+// fallback) to show what the fallback saves. ns/op is per transaction.
+void bench_block_executor() {
+    if (!bench::selected_group("block.")) return;
+    const size_t accounts = 100000;
+    const size_t block_size = bench::options.quick ? 1024 : 4096;
+    qOracle::BalanceTable table(qOracle::LedgerMode::Striped);
+    for (size_t i = 0; i < accounts; ++i) table.credit(static_cast<qOracle::AccountId>(i), 1000000000ULL);
+    table.credit(0, 1000000000000000ULL);
+    std::vector<qOracle::BlockLedger> ledgers = {{&table, nullptr}};
+    std::vector<bool> authorized(block_size, true);
+
+    auto make_block = [&](unsigned conflict_percent) {
+        bench::XorShift rng(conflict_percent + 1);
+        std::vector<qOracle::BlockTx> txs(block_size);
+        for (auto& tx : txs) {
+            bool hot = rng.next() % 100 < conflict_percent;
+            qOracle::AccountId from = hot ? 0 : static_cast<qOracle::AccountId>(1 + rng.next() % (accounts - 1));
+            qOracle::AccountId to = static_cast<qOracle::AccountId>(1 + rng.next() % (accounts - 1));
+            tx = {0, qOracle::TxKind::Transfer, from, from, to, 1};
+        }
+        return txs;
+    };
+
+    // Re-execution work of the last block run, next to its timing
+    qOracle::BlockResult last;
+    auto report_work = [&] {
+        std::fprintf(stderr, "%-32s %-32s     %10.2f executions/tx  %zu waves  %zu serial\n", "", "",
+                     static_cast<double>(last.executions) / static_cast<double>(block_size), last.waves,
+                     last.serial_executions);
+    };
+
+    const size_t threads = std::max(4u, std::thread::hardware_concurrency());
+    qOracle::BlockExecutor executor(threads);
+    for (unsigned conflict : {0u, 1u, 10u, 50u, 100u}) {
+        std::vector<qOracle::BlockTx> txs = make_block(conflict);
+        std::string params = "txs=" + std::to_string(block_size) + ",conflict=" + std::to_string(conflict) + "%";
+        bench::run("block.execute", params, [&](uint64_t) {
+            last = executor.execute(txs, ledgers, authorized);
+        }, bench::options.quick ? 50 : 500, block_size);
+        if (bench::selected("block.execute")) report_work();
+    }
+
+    qOracle::BlockExecutor speculative(threads, ~size_t(0));
+    std::vector<qOracle::BlockTx> chain = make_block(100);
+    bench::run("block.execute_no_fallback", "txs=" + std::to_string(block_size) + ",conflict=100%", [&](uint64_t) {
+        last = speculative.execute(chain, ledgers, authorized);
+    }, bench::options.quick ? 2 : 5, block_size);
+    if (bench::selected("block.execute_no_fallback")) report_work();
+    bench::keep(last.executions);
+}
+
+// Address-keyed map at ledger scale: insert and lookup throughput and
+// the heap bytes held per account. Keys are generated into one buffer
+// so the only string storage measured is the map's own. Bytes are the
+// sizes requested from operator new, so allocator headers (about 16 B per
+// block) are not counted; that flatters the node map, which allocates
+// twice per account.
+template <typename Map>
+void bench_hash_map(const char* kind, size_t accounts) {
+    char buffer[64];
+    std::string key;
+    auto make_key = [&](uint64_t i) -> const std::string& {
+        int n = std::snprintf(buffer, sizeof(buffer), "SP%039llu", static_cast<unsigned long long>(i));
+        key.assign(buffer, static_cast<size_t>(n));
+        return key;
+    };
+    make_key(0);
+
+    std::string params = std::string("map=") + kind + ",accounts=" + std::to_string(accounts);
+    uint64_t bytes_before = 0;
+    {
+        Map map;
+        bench::run_with_setup("hashmap.insert", params,
+            [&](uint64_t) -> uint64_t {
+                bytes_before = bench::allocated_bytes.load();
+                map.reserve(accounts);
+                return accounts;
+            },
+            [&](uint64_t) {
+                for (uint64_t i = 0; i < accounts; ++i) map.emplace(make_key(i), i);
+            }, 1);
+        bench::report_bytes("hashmap.insert", bench::allocated_bytes.load() - bytes_before, map.size());
+
+        uint64_t sink = 0;
+        bench::XorShift rng(accounts);
+        bench::run("hashmap.find", params, [&](uint64_t) {
+            auto it = map.find(make_key(rng.next() % accounts));
+            sink += it != map.end() ? it->second : 0;
+        });
+        bench::run("hashmap.find_miss", params, [&](uint64_t) {
+            sink += map.find(make_key(accounts + rng.next() % accounts)) != map.end();
+        });
+        bench::keep(sink);
+    }
+}
+
+// Payout-style transfers: one sender paying N recipients through N
+// single calls against one transfer_batch, and N independent transfers
+// through multi_transfer. ns/op is per transfer.
+void bench_batches(Fixture& fx) {
+    if (!bench::selected_group("batch.")) return;
+    const size_t accounts = 10000;
+    std::vector<qOracle::AccountId> ids = fx.fund_accounts("BATCH_", accounts, 1000000000000ULL);
+    auto* token = fx.system.get_bkpy_token();
+    uint64_t sink = 0;
+    bench::XorShift rng(31);
+
+    for (size_t n : {16, 256}) {
+        std::string params = "per_call=" + std::to_string(n);
+        std::vector<qOracle::TransferLeg> legs(n);
+        std::vector<qOracle::TransferOrder> orders(n);
+        auto draw = [&] {
+            for (size_t k = 0; k < n; ++k) {
+                legs[k] = {ids[rng.next() % accounts], 1};
+                orders[k] = {ids[rng.next() % accounts], ids[rng.next() % accounts], 1};
+            }
+        };
+        bench::run("batch.single_loop", params, [&](uint64_t) {
+            draw();
+            qOracle::AccountId sender = ids[rng.next() % accounts];
+            for (const auto& leg : legs) sink += token->transfer(sender, leg.to, leg.amount);
+        }, ~uint64_t(0), n);
+        bench::run("batch.transfer_batch", params, [&](uint64_t) {
+            draw();
+            sink += token->transfer_batch(ids[rng.next() % accounts], legs).applied;
+        }, ~uint64_t(0), n);
+        bench::run("batch.multi_transfer", params, [&](uint64_t) {
+            draw();
+            sink += token->multi_transfer(orders).applied;
+        }, ~uint64_t(0), n);
+        bench::run("batch.multi_transfer_best_effort", params, [&](uint64_t) {
+            draw();
+            sink += token->multi_transfer(orders, qOracle::BatchMode::BestEffort).applied;
+        }, ~uint64_t(0), n);
+    }
+    bench::keep(sink);
+}
+
+// Random transfers between funded accounts from 1 to 64 threads, each
+// thread on its own index stream. The bare table shows what striping or
+// lock-free balances buy; the token adds launch checks, logging and
+// event indexing as configured for production.
+void bench_transfer_scaling(Fixture& fx) {
+    if (!bench::selected_group("scaling.")) return;
+    const size_t accounts = 100000;
+    const uint64_t total_ops = bench::options.quick ? 200000 : 2000000;
+    std::string params = "accounts=" + std::to_string(accounts);
+
+    for (qOracle::LedgerMode mode : {qOracle::LedgerMode::Striped, qOracle::LedgerMode::LockFree}) {
+        qOracle::BalanceTable table(mode);
+        for (size_t i = 0; i < accounts; ++i) table.credit(static_cast<qOracle::AccountId>(i), 1000000000ULL);
+        std::string name = mode == qOracle::LedgerMode::Striped ? "scaling.table_transfer_striped"
+                                                                : "scaling.table_transfer_lockfree";
+        for (unsigned threads = 1; threads <= 64; threads *= 2) {
+            std::vector<bench::XorShift> streams;
+            for (unsigned t = 0; t < threads; ++t) streams.emplace_back(t + 1);
+            bench::run_threads(name, params, threads, total_ops / threads, [&](unsigned t, uint64_t) {
+                uint64_t r = streams[t].next();
+                table.transfer(static_cast<qOracle::AccountId>(r % accounts),
+                               static_cast<qOracle::AccountId>((r >> 32) % accounts), 1);
+            });
+        }
+    }
+
+    std::vector<qOracle::AccountId> ids = fx.fund_accounts("SCALING_", accounts, 1000000000ULL);
+    auto* token = fx.system.get_bkpy_token();
+    const uint64_t token_ops = total_ops / 10;
+    for (unsigned threads = 1; threads <= 64; threads *= 2) {
+        std::vector<bench::XorShift> streams;
+        for (unsigned t = 0; t < threads; ++t) streams.emplace_back(t + 1);
+        bench::run_threads("scaling.bkpy_transfer_id", params, threads, token_ops / threads, [&](unsigned t, uint64_t) {
+            uint64_t r = streams[t].next();
+            token->transfer(ids[r % accounts], ids[(r >> 32) % accounts], 1);
+        });
+    }
+}
+
+void bench_hash_maps() {
+    if (!bench::selected_group("hashmap.")) return;
+    const size_t accounts = bench::options.quick ? 1000000 : 10000000;
+    bench_hash_map<qOracle::FlatHashMap<std::string, uint64_t>>("flat", accounts);
+    bench_hash_map<std::unordered_map<std::string, uint64_t>>("std_unordered", accounts);
+}
+
+void bench_bridge(Fixture& fx) {
+    auto* bridge = fx.system.get_bridge();
+    qOracle::VerifiedPrice price = fx.system.get_oracle_committee()->verified_price();
+    const size_t users = 4096;
+    std::vector<std::string> names;
+    for (size_t i = 0; i < users; ++i) names.push_back("SWAPPER" + std::to_string(i));
+
+    // Burns replay the mints in the same order, so every burn is funded
+    uint64_t failures = 0, minted = 0;
+    bench::run("bridge.swap_stx_for_qbtc", "users=4096", [&](uint64_t i) {
+        failures += !bridge->swap_stx_for_qbtc(names[i % users], SWAP_AMOUNT, price);
+        ++minted;
+    });
+    bench::run("bridge.swap_qbtc_for_stx", "users=4096", [&](uint64_t i) {
+        failures += !bridge->swap_qbtc_for_stx(names[i % users], SWAP_AMOUNT, price);
+    }, minted);
+    bench::run("bridge.quote_batch", "amounts=1024", [&](uint64_t) {
+        static std::vector<uint64_t> amounts(1024, 123456789), out;
+        failures += !bridge->quote_batch(amounts, price.price(), out);
+    }, ~uint64_t(0), 1024);
+
+    // Swap throughput with every thread on its own users, then with all
+    // threads sharing 8 hot users so they race on the same balances and
+    // per-account limits. Each thread burns back what it just minted on
+    // the same user, so every burn is funded either way.
+    std::atomic<uint64_t> contended_failures{0};
+    auto swap_pair = [&](const std::string& user, uint64_t i) {
+        bool ok = (i & 1) ? bridge->swap_qbtc_for_stx(user, SWAP_AMOUNT, price)
+                          : bridge->swap_stx_for_qbtc(user, SWAP_AMOUNT, price);
+        if (!ok) contended_failures.fetch_add(1, std::memory_order_relaxed);
+    };
+    const size_t hot_users = 8;
+    unsigned max_threads = bench::options.quick ? 2 : 8;
+    uint64_t contended_ops = bench::options.quick ? 2000 : 20000;
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        bench::run_threads("bridge.swap_contended", "users_per_thread=256", threads, contended_ops,
+                           [&](unsigned t, uint64_t i) { swap_pair(names[(t * 256 + (i / 2) % 256) % users], i); });
+        bench::run_threads("bridge.swap_contended_shared", "users=8", threads, contended_ops,
+                           [&](unsigned t, uint64_t i) { swap_pair(names[(t + i / 2) % hot_users], i); });
+    }
+    failures += contended_failures.load();
+    if (failures) std::fprintf(stderr, "bridge: %llu swaps rejected\n", static_cast<unsigned long long>(failures));
+}
+
+void bench_governance() {
+    if (!bench::selected_group("governance.")) return;
+    auto logger = std::make_shared<ThreadSafeLogger>("qoracle_governance_bench.log");
+    std::vector<std::string> owners = {"OWNER0", "OWNER1", "OWNER2", "OWNER3", "OWNER4"};
+    governance_clock.store(bench::now_seconds());
+    QnosisMultisig multisig(DEPLOYER, owners, 3, logger, false, read_governance_clock);
+    multisig.finalizeLaunch(DEPLOYER);
+
+    const uint64_t batch_proposals = bench::options.quick ? 20000 : 200000;
+    std::vector<uint64_t> nonces;
+    nonces.reserve(batch_proposals);
+    auto propose_all = [&] {
+        nonces.clear();
+        for (uint64_t i = 0; i < batch_proposals; ++i) nonces.push_back(multisig.propose("OWNER0", "T", i, "", "signal", ""));
+    };
+
+    uint64_t sink = 0;
+    bench::run("governance.propose", "", [&](uint64_t i) {
+        sink += multisig.propose("OWNER0", "T", i, "", "signal", "");
+    }, batch_proposals);
+
+    propose_all();
+    bench::run("governance.sign", "", [&](uint64_t i) { multisig.sign(nonces[i], "OWNER1"); }, nonces.size());
+
+    // Batch vs single signing of the same number of proposals
+    const uint64_t BATCH = 64;
+    propose_all();
+    bench::run("governance.sign_single", "per_call=1", [&](uint64_t i) {
+        for (uint64_t k = 0; k < BATCH; ++k) multisig.sign(nonces[i * BATCH + k], "OWNER1");
+    }, nonces.size() / BATCH, BATCH);
+    propose_all();
+    bench::run("governance.sign_batch", "per_call=64", [&](uint64_t i) {
+        std::vector<uint64_t> chunk(nonces.begin() + i * BATCH, nonces.begin() + (i + 1) * BATCH);
+        sink += multisig.sign_batch("OWNER1", chunk).size();
+    }, nonces.size() / BATCH, BATCH);
+
+    // Execution of proposals past their delay with threshold signatures
+    propose_all();
+    for (const char* signer : {"OWNER1", "OWNER2", "OWNER3"}) multisig.sign_batch(signer, nonces);
+    governance_clock.fetch_add(qOracleConfig::GOVERNANCE_EXECUTION_DELAY + 1);
+    multisig.tick();
+    bench::run("governance.execute", "", [&](uint64_t i) { multisig.execute(nonces[i]); }, nonces.size());
+    bench::keep(sink);
+}
+
+void bench_timing_wheel() {
+    const uint64_t pending = bench::options.quick ? 100000 : 1000000;
+    std::string params = "pending=" + std::to_string(pending);
+    bench::XorShift rng(7);
+    const uint64_t horizon = 7 * 86400;
+
+    qOracle::TimingWheel wheel(0);
+    if (bench::selected_group("timing_wheel.")) {
+        for (uint64_t i = 0; i < pending; ++i) wheel.schedule(1 + rng.next() % horizon, i);
+    }
+    bench::run("timing_wheel.schedule_cancel", params, [&](uint64_t i) {
+        wheel.cancel(wheel.schedule(1 + rng.next() % horizon, i));
+    });
+
+    uint64_t fired = 0;
+    std::unique_ptr<qOracle::TimingWheel> drained;
+    bench::run_with_setup("timing_wheel.advance", params,
+        [&](uint64_t) -> uint64_t {
+            drained.reset(new qOracle::TimingWheel(0));
+            for (uint64_t i = 0; i < pending; ++i) drained->schedule(1 + rng.next() % horizon, i);
+            return pending;
+        },
+        [&](uint64_t) { fired += drained->advance(horizon, [](uint64_t, uint64_t) {}); },
+        bench::options.quick ? 2 : 5);
+}
+
+void bench_counters() {
+    unsigned max_threads = bench::options.quick ? 2 : 8;
+    uint64_t ops = bench::options.quick ? 200000 : 2000000;
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        std::atomic<uint64_t> single{0};
+        bench::run_threads("counter.atomic_add", "", threads, ops, [&](unsigned, uint64_t) { single.fetch_add(1); });
+        qOracle::ShardedCounter sharded;
+        bench::run_threads("counter.sharded_add", "", threads, ops, [&](unsigned, uint64_t) { sharded.add(1); });
+    }
+    qOracle::ShardedCounter counter;
+    counter.add(12345);
+    uint64_t sink = 0;
+    bench::run("counter.sharded_load", "", [&](uint64_t) { sink += counter.load(); });
+    bench::run("counter.sharded_load_exact", "", [&](uint64_t) { sink += counter.load_exact(); });
+    bench::keep(sink);
+}
+
+void bench_fixed_point() {
+    std::vector<uint64_t> amounts(1024), out(1024);
+    bench::XorShift rng(3);
+    for (auto& a : amounts) a = rng.next() % 100000000000ULL;
+    uint64_t sink = 0;
+    bench::run("fixed_point.quote", "", [&](uint64_t i) {
+        uint64_t q = 0;
+        qOracle::quote<15>(amounts[i % 1024], BENCH_PRICE * 3, q);
+        sink += q;
+    });
+    bench::run("fixed_point.quote_batch", "amounts=1024", [&](uint64_t) {
+        qOracle::quote_batch<15>(amounts.data(), out.data(), amounts.size(), BENCH_PRICE * 3);
+        sink += out[0];
+    }, ~uint64_t(0), 1024);
+    bench::keep(sink);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--quick") {
+            bench::options.quick = true;
+            bench::options.min_seconds = 0.1;
+        } else if (arg == "--filter" && i + 1 < argc) {
+            bench::options.filter = argv[++i];
+        } else if (arg == "--out" && i + 1 < argc) {
+            bench::options.out = argv[++i];
+        } else if (arg == "--seconds" && i + 1 < argc) {
+            bench::options.min_seconds = std::atof(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--quick] [--filter substring] [--seconds s] [--out file.json]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    try {
+        Fixture fixture;
+        bench_event_store();
+        bench_price_messages(fixture);
+        bench_committee(fixture);
+        bench_ledger(fixture);
+        bench_snapshots();
+        bench_batches(fixture);
+        bench_transfer_scaling(fixture);
+        bench_hash_maps();
+        bench_block_executor();
+        bench_bridge(fixture);
+        bench_governance();
+        bench_timing_wheel();
+        bench_counters();
+        bench_fixed_point();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "Benchmark failed: %s\n", e.what());
+        return 1;
+    }
+
+    std::string json = bench::to_json();
+    if (bench::options.out.empty()) {
+        std::fputs(json.c_str(), stdout);
+    } else {
+        FILE* file = std::fopen(bench::options.out.c_str(), "w");
+        if (!file) {
+            std::fprintf(stderr, "Cannot write %s\n", bench::options.out.c_str());
+            return 1;
+        }
+        std::fputs(json.c_str(), file);
+        std::fclose(file);
+    }
+    return 0;
+}
@@ -0,0 +1,681 @@
+/*
+ * qOracle Load Generator
+ * End-to-end load on a local QOracleSystem with a simulated oracle committee
+ *
+ * Seven simulated oracles sign a price stream for each asset at a fixed
+ * rate while worker threads play a user population: BKPY transfers,
+ * bridge swaps in both directions, and governance proposals, signatures
+ * and executions. A block thread ticks governance, settles netted swaps
+ * and commits the ledgers once per block interval.
+ *
+ * Load is open-loop. Each step of the sweep offers a fixed number of
+ * user operations per second, scheduled in advance across the workers.
+ * A worker that falls behind issues overdue operations back to back and
+ * times each from when it was due, so queueing inside a saturated system
+ * shows up in the percentiles instead of quietly lowering the offered
+ * rate. The sweep raises the offered rate until achieved throughput
+ * falls below 90% of it or the p99 exceeds the latency target; the last
+ * step that kept up is the saturation point.
+ *
+ * Asset 0 (BTC) is priced by the system's own committee and drives the
+ * bridge; each further asset gets its own committee with the same
+ * oracle keys, as a deployment runs one committee per feed. Governance
+ * runs on an accelerated clock (a day per second by default) so
+ * proposals clear their execution delay within a step.
+ *
+ * Build:  g++ -std=c++17 -O2 -o qOracle_LoadGen qOracle_LoadGen.cpp -lcrypto -lpthread
+ * Run:    ./run_loadgen.sh [options]    (--help lists them)
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#define QORACLE_NO_MAIN
+#include "qOracle_Production_RC2.cpp"
+#include "OracleSimulator.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <sstream>
+
+namespace loadgen {
+
+using Clock = std::chrono::steady_clock;
+
+enum Op : size_t {
+    Transfer,
+    SwapStxForQbtc,
+    SwapQbtcForStx,
+    GovernancePropose,
+    GovernanceSign,
+    GovernanceExecute,
+    PriceUpdate,            // Oracle feed, at its own fixed rate
+    BlockCommit,            // Block thread, at its own fixed rate
+    OP_COUNT
+};
+
+constexpr std::array<const char*, OP_COUNT> OP_NAMES = {
+    "transfer", "swap_stx_for_qbtc", "swap_qbtc_for_stx", "governance.propose",
+    "governance.sign", "governance.execute", "oracle.price_update", "block.commit"
+};
+
+// Operations counted against the offered rate
+constexpr size_t USER_OPS = PriceUpdate;
+
+struct Options {
+    std::vector<uint64_t> rates;        // Offered user ops/s per step; empty: double from start_rate
+    uint64_t start_rate = 500;
+    uint64_t max_rate = 1000000;
+    double step_seconds = 5;
+    unsigned threads = 4;
+    size_t users = 10000;
+    size_t assets = 4;
+    double price_rate = 2;              // Signed updates per asset per second
+    double block_seconds = 1;
+    unsigned transfer_weight = 80;
+    unsigned swap_weight = 15;
+    unsigned governance_weight = 5;
+    double slo_ms = 50;                 // p99 target for user operations
+    uint64_t governance_speedup = 86400;
+    std::string out;
+};
+
+// Log-linear histogram: 16 sub-buckets per power of two, so a reported
+// percentile is within 1/16 of the true value. Each thread keeps its own
+// and they are merged after a step, so recording takes no atomics.
+class Histogram {
+    static constexpr unsigned SUB_BITS = 4;
+    static constexpr size_t SUB = size_t(1) << SUB_BITS;
+    static constexpr size_t BUCKETS = (64 - SUB_BITS + 1) * SUB;
+
+    std::array<uint64_t, BUCKETS> counts{};
+    uint64_t total = 0;
+    uint64_t sum = 0;
+    uint64_t largest = 0;
+
+    static size_t index(uint64_t ns) {
+        if (ns < SUB) return static_cast<size_t>(ns);
+        unsigned shift = (63 - __builtin_clzll(ns)) - SUB_BITS;
+        return (shift + 1) * SUB + ((ns >> shift) & (SUB - 1));
+    }
+
+    // Largest value that lands in bucket i
+    static uint64_t upper(size_t i) {
+        if (i < SUB) return i;
+        unsigned shift = static_cast<unsigned>(i / SUB - 1);
+        return ((SUB + i % SUB + 1) << shift) - 1;
+    }
+
+public:
+    void record(uint64_t ns) {
+        ++counts[index(ns)];
+        ++total;
+        sum += ns;
+        largest = ns > largest ? ns : largest;
+    }
+
+    void merge(const Histogram& other) {
+        for (size_t i = 0; i < BUCKETS; ++i) counts[i] += other.counts[i];
+        total += other.total;
+        sum += other.sum;
+        largest = other.largest > largest ? other.largest : largest;
+    }
+
+    uint64_t count() const { return total; }
+    uint64_t max() const { return largest; }
+    double mean() const { return total ? static_cast<double>(sum) / static_cast<double>(total) : 0; }
+
+    uint64_t quantile(double q) const {
+        if (total == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(total)));
+        rank = rank ? rank : 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            seen += counts[i];
+            if (seen >= rank) return std::min(upper(i), largest);
+        }
+        return largest;
+    }
+};
+
+struct ThreadStats {
+    std::array<Histogram, OP_COUNT> latency;
+    std::array<uint64_t, OP_COUNT> errors{};
+    uint64_t scheduled = 0;             // User operations due in the step
+};
+
+struct XorShift {
+    uint64_t state;
+    explicit XorShift(uint64_t seed) : state(seed ? seed : 1) {}
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+uint64_t now_seconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+uint64_t elapsed_ns(Clock::time_point from, Clock::time_point to) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+}
+
+// Governance clock: wall time at start plus accelerated elapsed time
+uint64_t governance_epoch = 0;
+Clock::time_point governance_origin;
+uint64_t governance_speedup = 1;
+
+uint64_t governance_time() {
+    uint64_t elapsed = elapsed_ns(governance_origin, Clock::now());
+    return governance_epoch + static_cast<uint64_t>(static_cast<double>(elapsed) * 1e-9 *
+                                                    static_cast<double>(governance_speedup));
+}
+
+// Walks proposals through their whole life: proposed by owner 0, signed
+// by owners 1..threshold, executed once the delay has passed
+class GovernanceFlow {
+public:
+    static constexpr uint32_t THRESHOLD = 3;    // QOracleSystem's multisig threshold
+
+    struct Call {
+        Op op;
+        uint64_t nonce;
+        size_t owner;
+    };
+
+private:
+    struct Open {
+        uint64_t nonce;
+        uint64_t ready_at;
+        uint32_t signatures;
+    };
+
+    std::mutex mutex;
+    std::deque<Open> open;      // In proposal order
+    size_t signing = 0;         // Entries before this one hold THRESHOLD signatures
+
+public:
+    Call next(uint64_t now) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (signing > 0 && open.front().ready_at <= now) {
+            uint64_t nonce = open.front().nonce;
+            open.pop_front();
+            --signing;
+            return {GovernanceExecute, nonce, 0};
+        }
+        if (signing < open.size()) {
+            Open& proposal = open[signing];
+            uint32_t owner = ++proposal.signatures;
+            if (proposal.signatures == THRESHOLD) ++signing;
+            return {GovernanceSign, proposal.nonce, owner};
+        }
+        return {GovernancePropose, 0, 0};
+    }
+
+    // Record a proposal created no later than created
+    void proposed(uint64_t nonce, uint64_t created) {
+        std::lock_guard<std::mutex> lock(mutex);
+        open.push_back({nonce, created + qOracleConfig::GOVERNANCE_EXECUTION_DELAY + 1, 0});
+    }
+};
+
+const std::string DEPLOYER = "ST1SJ3DTE5DN7X54YDH5D64R3BCB6A2AG2ZQ8YPD5";
+constexpr uint64_t SWAP_AMOUNT = qOracleConfig::MIN_SWAP_AMOUNT;
+constexpr uint64_t PRICE_SCALE = 1000000000000000ULL;  // 15 decimals
+
+// One asset's signed price stream
+struct Feed {
+    std::string asset;
+    QOracleCommittee* committee;
+    uint64_t price;
+    uint64_t nonce = 0;
+};
+
+class LoadGenerator {
+    const Options& options;
+    qOracle::OracleSimulator oracles;
+    std::vector<std::string> owners;
+    std::unique_ptr<QOracleSystem> system;
+    std::shared_ptr<ThreadSafeLogger> feed_logger;
+    std::shared_ptr<qOracle::EventStore> feed_events;
+    std::vector<std::unique_ptr<QOracleCommittee>> extra_committees;
+    std::vector<Feed> feeds;
+    std::vector<std::string> users;
+    std::vector<qOracle::AccountId> user_ids;
+    GovernanceFlow governance_flow;
+    XorShift feed_rng{99};
+
+    void build() {
+        governance_epoch = now_seconds();
+        governance_origin = Clock::now();
+        governance_speedup = options.governance_speedup;
+
+        for (size_t i = 0; i < 5; ++i) owners.push_back("GOV_OWNER" + std::to_string(i));
+        system = std::make_unique<QOracleSystem>(DEPLOYER, oracles.public_keys(), oracles.oracle_addresses(),
+                                                 owners, DEPLOYER, governance_time);
+        system->initialize_system(DEPLOYER);
+        system->get_bridge()->set_daily_volume_limit(DEPLOYER, qOracle::VolumeLimiter::MAX_LIMIT);
+        system->get_bridge()->set_account_volume_limit(DEPLOYER, qOracle::VolumeLimiter::MAX_LIMIT);
+
+        static const char* ASSETS[] = {"BTC", "ETH", "STX", "QUBIC", "SOL", "XMR", "ADA", "DOT"};
+        feed_logger = std::make_shared<ThreadSafeLogger>("qoracle_loadgen_feeds.log");
+        feed_events = std::make_shared<qOracle::EventStore>("qoracle_loadgen_events");
+        for (size_t a = 0; a < options.assets; ++a) {
+            QOracleCommittee* committee = system->get_oracle_committee();
+            if (a > 0) {
+                extra_committees.push_back(std::make_unique<QOracleCommittee>(
+                    DEPLOYER, oracles.public_keys(), oracles.oracle_addresses(), feed_logger));
+                committee = extra_committees.back().get();
+                committee->attachEventStore(feed_events);
+                committee->finalizeLaunch(DEPLOYER);
+            }
+            std::string asset = a < 8 ? ASSETS[a] : "ASSET" + std::to_string(a);
+            feeds.push_back({asset, committee, PRICE_SCALE * (a + 1)});
+            if (!publish(feeds.back())) throw std::runtime_error("Initial " + asset + " price rejected");
+        }
+
+        // Fund the population with BKPY for transfers
+        auto* registry = system->get_address_registry();
+        qOracle::AccountId admin = registry->intern(DEPLOYER);
+        std::vector<qOracle::TransferLeg> legs;
+        for (size_t i = 0; i < options.users; ++i) {
+            users.push_back("LOADUSER" + std::to_string(i));
+            user_ids.push_back(registry->intern(users.back()));
+            legs.push_back({user_ids.back(), 1000000000ULL});
+            if (legs.size() == 4096 || i + 1 == options.users) {
+                system->get_bkpy_token()->transfer_batch(admin, legs);
+                legs.clear();
+            }
+        }
+    }
+
+    // Sign and submit the next point of a feed's random walk (+/-0.5%)
+    bool publish(Feed& feed, Histogram* latency = nullptr) {
+        int64_t step = static_cast<int64_t>(feed_rng.next() % 1001) - 500;
+        feed.price = static_cast<uint64_t>(static_cast<int64_t>(feed.price) +
+                                           static_cast<int64_t>(feed.price / 100000) * step / 10);
+        qOracle::PriceMessage message(feed.price, now_seconds(), 15, ++feed.nonce, feed.asset);
+        qOracle::PriceUpdate update = oracles.make_update(message);
+
+        auto start = Clock::now();
+        bool accepted = feed.committee->submit_price_update(update);
+        if (latency) latency->record(elapsed_ns(start, Clock::now()));
+        return accepted;
+    }
+
+    bool run_user_op(Op op, size_t user, size_t peer) {
+        switch (op) {
+            case Transfer:
+                return system->get_bkpy_token()->transfer(users[user], users[peer], 1);
+            case SwapStxForQbtc:
+                return system->get_bridge()->swap_stx_for_qbtc(
+                    users[user], SWAP_AMOUNT, system->get_oracle_committee()->verified_price());
+            case SwapQbtcForStx:
+                return system->get_bridge()->swap_qbtc_for_stx(
+                    users[user], SWAP_AMOUNT, system->get_oracle_committee()->verified_price());
+            default:
+                return false;
+        }
+    }
+
+    // One governance call; returns the op it turned out to be
+    Op run_governance(bool& ok) {
+        QnosisMultisig* multisig = system->get_governance();
+        GovernanceFlow::Call call = governance_flow.next(governance_time());
+        switch (call.op) {
+            case GovernancePropose: {
+                // Alternate a pure vote with a dispatched no-op limit change
+                static std::atomic<uint64_t> count{0};
+                bool signal = count.fetch_add(1) % 2 == 0;
+                uint64_t nonce = multisig->propose(owners[0], qOracleConfig::GOVERNANCE_ACCOUNT, 0, "",
+                    signal ? "signal" : "set_account_volume_limit",
+                    signal ? "" : std::to_string(qOracle::VolumeLimiter::MAX_LIMIT));
+                ok = nonce != 0;
+                if (ok) governance_flow.proposed(nonce, governance_time());
+                break;
+            }
+            case GovernanceSign:
+                multisig->sign(call.nonce, owners[call.owner]);
+                ok = true;
+                break;
+            default:
+                multisig->execute(call.nonce);
+                ok = multisig->isExecuted(call.nonce);
+                break;
+        }
+        return call.op;
+    }
+
+    void worker(unsigned thread, uint64_t rate, Clock::time_point start, Clock::time_point end,
+                ThreadStats& stats) {
+        XorShift rng(thread * 7919 + rate);
+        const unsigned weights = options.transfer_weight + options.swap_weight + options.governance_weight;
+        const double interval = static_cast<double>(options.threads) * 1e9 / static_cast<double>(rate);
+        const double offset = interval * thread / options.threads;
+        auto& qbtc = *system->get_qbtc_token();
+
+        for (uint64_t k = 0;; ++k) {
+            auto due = start + std::chrono::nanoseconds(static_cast<int64_t>(offset + interval * static_cast<double>(k)));
+            if (due >= end) break;
+            ++stats.scheduled;
+
+            // Time from when the op was due; if the worker was early, from
+            // when it woke, so timer slack is not charged to the system
+            auto begin = due;
+            if (Clock::now() < due) {
+                std::this_thread::sleep_until(due);
+                begin = Clock::now();
+            }
+
+            unsigned pick = static_cast<unsigned>(rng.next() % weights);
+            Op op;
+            bool ok;
+            if (pick < options.transfer_weight) {
+                op = Transfer;
+                ok = run_user_op(op, rng.next() % users.size(), rng.next() % users.size());
+            } else if (pick < options.transfer_weight + options.swap_weight) {
+                // Swappers are partitioned by thread so the balance check holds
+                size_t slice = (users.size() + options.threads - 1) / options.threads;
+                size_t user = std::min(users.size() - 1, thread * slice + rng.next() % slice);
+                op = qbtc.balanceOf(user_ids[user]) >= SWAP_AMOUNT && (rng.next() & 1) ? SwapQbtcForStx : SwapStxForQbtc;
+                ok = run_user_op(op, user, 0);
+            } else {
+                op = run_governance(ok);
+            }
+            stats.latency[op].record(elapsed_ns(begin, Clock::now()));
+            stats.errors[op] += !ok;
+        }
+    }
+
+    // Calls tick() every period seconds until end; each call is timed
+    template <typename Tick>
+    void periodic(double period, Clock::time_point start, Clock::time_point end, Tick&& tick) {
+        for (uint64_t k = 0;; ++k) {
+            auto due = start + std::chrono::nanoseconds(static_cast<int64_t>(period * 1e9 * static_cast<double>(k)));
+            if (due >= end) break;
+            std::this_thread::sleep_until(due);
+            tick();
+        }
+    }
+
+public:
+    struct OpResult {
+        uint64_t count = 0;
+        uint64_t errors = 0;
+        double throughput = 0;
+        double mean_ns = 0;
+        uint64_t p50_ns = 0;
+        uint64_t p99_ns = 0;
+        uint64_t p999_ns = 0;
+        uint64_t max_ns = 0;
+    };
+
+    struct StepResult {
+        uint64_t offered_rate = 0;
+        double achieved_rate = 0;
+        double seconds = 0;
+        uint64_t scheduled = 0;
+        uint64_t completed = 0;
+        uint64_t p50_ns = 0;
+        uint64_t p99_ns = 0;
+        uint64_t p999_ns = 0;
+        bool saturated = false;
+        std::array<OpResult, OP_COUNT> ops;
+    };
+
+    explicit LoadGenerator(const Options& opts) : options(opts) { build(); }
+
+    StepResult step(uint64_t rate) {
+        std::vector<ThreadStats> stats(options.threads + 2);
+        ThreadStats& feed_stats = stats[options.threads];
+        ThreadStats& block_stats = stats[options.threads + 1];
+
+        auto start = Clock::now() + std::chrono::milliseconds(10);
+        auto end = start + std::chrono::nanoseconds(static_cast<int64_t>(options.step_seconds * 1e9));
+
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < options.threads; ++t) {
+            threads.emplace_back([&, t] { worker(t, rate, start, end, stats[t]); });
+        }
+        // The seven oracles publish every feed in turn at the configured rate
+        threads.emplace_back([&] {
+            double period = 1.0 / (options.price_rate * static_cast<double>(feeds.size()));
+            size_t next = 0;
+            periodic(period, start, end, [&] {
+                Feed& feed = feeds[next++ % feeds.size()];
+                feed_stats.errors[PriceUpdate] += !publish(feed, &feed_stats.latency[PriceUpdate]);
+            });
+        });
+        threads.emplace_back([&] {
+            periodic(options.block_seconds, start, end, [&] {
+                auto begin = Clock::now();
+                system->execute_block({});
+                block_stats.latency[BlockCommit].record(elapsed_ns(begin, Clock::now()));
+            });
+        });
+        for (auto& thread : threads) thread.join();
+        auto finished = Clock::now();
+
+        ThreadStats merged;
+        for (const ThreadStats& s : stats) {
+            for (size_t op = 0; op < OP_COUNT; ++op) {
+                merged.latency[op].merge(s.latency[op]);
+                merged.errors[op] += s.errors[op];
+            }
+            merged.scheduled += s.scheduled;
+        }
+
+        StepResult result;
+        result.offered_rate = rate;
+        result.seconds = static_cast<double>(elapsed_ns(start, finished)) * 1e-9;
+        result.scheduled = merged.scheduled;
+        Histogram user_latency;
+        for (size_t op = 0; op < OP_COUNT; ++op) {
+            const Histogram& h = merged.latency[op];
+            OpResult& r = result.ops[op];
+            r.count = h.count();
+            r.errors = merged.errors[op];
+            r.throughput = static_cast<double>(r.count) / result.seconds;
+            r.mean_ns = h.mean();
+            r.p50_ns = h.quantile(0.50);
+            r.p99_ns = h.quantile(0.99);
+            r.p999_ns = h.quantile(0.999);
+            r.max_ns = h.max();
+            if (op < USER_OPS) {
+                result.completed += r.count;
+                user_latency.merge(h);
+            }
+        }
+        result.achieved_rate = static_cast<double>(result.completed) / result.seconds;
+        result.p50_ns = user_latency.quantile(0.50);
+        result.p99_ns = user_latency.quantile(0.99);
+        result.p999_ns = user_latency.quantile(0.999);
+        result.saturated = result.achieved_rate < 0.9 * static_cast<double>(rate) ||
+                           static_cast<double>(result.p99_ns) > options.slo_ms * 1e6;
+        return result;
+    }
+};
+
+void print_step(const LoadGenerator::StepResult& step) {
+    std::fprintf(stderr, "\noffered %llu ops/s  achieved %.0f ops/s  p50 %.1f us  p99 %.1f us  p999 %.1f us%s\n",
+                 static_cast<unsigned long long>(step.offered_rate), step.achieved_rate,
+                 step.p50_ns / 1e3, step.p99_ns / 1e3, step.p999_ns / 1e3, step.saturated ? "  SATURATED" : "");
+    for (size_t op = 0; op < OP_COUNT; ++op) {
+        const auto& r = step.ops[op];
+        if (r.count == 0) continue;
+        std::fprintf(stderr, "  %-22s %9llu ops %7llu err %10.1f ops/s  p50 %9.1f us  p99 %9.1f us  p999 %9.1f us\n",
+                     OP_NAMES[op], static_cast<unsigned long long>(r.count), static_cast<unsigned long long>(r.errors),
+                     r.throughput, r.p50_ns / 1e3, r.p99_ns / 1e3, r.p999_ns / 1e3);
+    }
+}
+
+std::string to_json(const Options& options, const std::vector<LoadGenerator::StepResult>& steps) {
+    char buffer[512];
+    std::string out = "{\n  \"tool\": \"qOracle load generator\",\n";
+    std::snprintf(buffer, sizeof(buffer),
+                  "  \"config\": {\"threads\": %u, \"users\": %zu, \"assets\": %zu, \"price_rate\": %.2f, "
+                  "\"block_seconds\": %.2f, \"mix\": \"%u:%u:%u\", \"step_seconds\": %.2f, \"slo_ms\": %.2f, "
+                  "\"governance_speedup\": %llu, \"hardware_threads\": %u},\n  \"steps\": [\n",
+                  options.threads, options.users, options.assets, options.price_rate, options.block_seconds,
+                  options.transfer_weight, options.swap_weight, options.governance_weight, options.step_seconds,
+                  options.slo_ms, static_cast<unsigned long long>(options.governance_speedup),
+                  std::thread::hardware_concurrency());
+    out += buffer;
+
+    const LoadGenerator::StepResult* sustained = nullptr;
+    const LoadGenerator::StepResult* saturated = nullptr;
+    for (size_t i = 0; i < steps.size(); ++i) {
+        const auto& step = steps[i];
+        if (!step.saturated && !saturated) sustained = &step;
+        if (step.saturated && !saturated) saturated = &step;
+
+        std::snprintf(buffer, sizeof(buffer),
+                      "    {\"offered_rate\": %llu, \"achieved_rate\": %.1f, \"seconds\": %.3f, \"scheduled\": %llu, "
+                      "\"completed\": %llu, \"p50_ns\": %llu, \"p99_ns\": %llu, \"p999_ns\": %llu, "
+                      "\"saturated\": %s, \"operations\": [\n",
+                      static_cast<unsigned long long>(step.offered_rate), step.achieved_rate, step.seconds,
+                      static_cast<unsigned long long>(step.scheduled), static_cast<unsigned long long>(step.completed),
+                      static_cast<unsigned long long>(step.p50_ns), static_cast<unsigned long long>(step.p99_ns),
+                      static_cast<unsigned long long>(step.p999_ns), step.saturated ? "true" : "false");
+        out += buffer;
+        bool first = true;
+        for (size_t op = 0; op < OP_COUNT; ++op) {
+            const auto& r = step.ops[op];
+            if (r.count == 0) continue;
+            std::snprintf(buffer, sizeof(buffer),
+                          "%s      {\"name\": \"%s\", \"count\": %llu, \"errors\": %llu, \"throughput\": %.1f, "
+                          "\"mean_ns\": %.0f, \"p50_ns\": %llu, \"p99_ns\": %llu, \"p999_ns\": %llu, \"max_ns\": %llu}",
+                          first ? "" : ",\n", OP_NAMES[op], static_cast<unsigned long long>(r.count),
+                          static_cast<unsigned long long>(r.errors), r.throughput, r.mean_ns,
+                          static_cast<unsigned long long>(r.p50_ns), static_cast<unsigned long long>(r.p99_ns),
+                          static_cast<unsigned long long>(r.p999_ns), static_cast<unsigned long long>(r.max_ns));
+            out += buffer;
+            first = false;
+        }
+        out += std::string("\n    ]}") + (i + 1 < steps.size() ? "," : "") + "\n";
+    }
+
+    std::snprintf(buffer, sizeof(buffer),
+                  "  ],\n  \"saturation\": {\"max_sustained_offered_rate\": %llu, \"max_sustained_achieved_rate\": %.1f, "
+                  "\"first_saturated_offered_rate\": %s}\n}\n",
+                  static_cast<unsigned long long>(sustained ? sustained->offered_rate : 0),
+                  sustained ? sustained->achieved_rate : 0.0,
+                  saturated ? std::to_string(saturated->offered_rate).c_str() : "null");
+    out += buffer;
+    return out;
+}
+
+void usage(const char* program) {
+    std::fprintf(stderr,
+        "usage: %s [options]\n"
+        "  --rates r1,r2,...       offered user ops/s per step (default: double from --start-rate)\n"
+        "  --start-rate n          first offered rate of the doubling sweep (500)\n"
+        "  --max-rate n            stop the doubling sweep here (1000000)\n"
+        "  --step-seconds s        length of each step (5)\n"
+        "  --threads n             user worker threads (4)\n"
+        "  --users n               user population (10000)\n"
+        "  --assets n              price feeds, one committee each (4)\n"
+        "  --price-rate hz         signed updates per asset per second (2)\n"
+        "  --block-seconds s       block interval for tick, settlement and commit (1)\n"
+        "  --mix t:s:g             transfer:swap:governance weights (80:15:5)\n"
+        "  --slo-ms ms             p99 above this counts as saturated (50)\n"
+        "  --governance-speedup n  governance seconds per real second (86400)\n"
+        "  --quick                 1 s steps and 1000 users\n"
+        "  --out file.json         write results here instead of stdout\n", program);
+}
+
+bool parse_mix(const std::string& text, Options& options) {
+    unsigned t, s, g;
+    if (std::sscanf(text.c_str(), "%u:%u:%u", &t, &s, &g) != 3 || t + s + g == 0) return false;
+    options.transfer_weight = t;
+    options.swap_weight = s;
+    options.governance_weight = g;
+    return true;
+}
+
+} // namespace loadgen
+
+int main(int argc, char** argv) {
+    loadgen::Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--quick") {
+            options.step_seconds = 1;
+            options.users = 1000;
+        } else if (arg == "--rates" && has_value) {
+            std::stringstream list(argv[++i]);
+            for (std::string rate; std::getline(list, rate, ',');) options.rates.push_back(std::strtoull(rate.c_str(), nullptr, 10));
+        } else if (arg == "--start-rate" && has_value) {
+            options.start_rate = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--max-rate" && has_value) {
+            options.max_rate = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--step-seconds" && has_value) {
+            options.step_seconds = std::atof(argv[++i]);
+        } else if (arg == "--threads" && has_value) {
+            options.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (arg == "--users" && has_value) {
+            options.users = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--assets" && has_value) {
+            options.assets = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--price-rate" && has_value) {
+            options.price_rate = std::atof(argv[++i]);
+        } else if (arg == "--block-seconds" && has_value) {
+            options.block_seconds = std::atof(argv[++i]);
+        } else if (arg == "--mix" && has_value && loadgen::parse_mix(argv[i + 1], options)) {
+            ++i;
+        } else if (arg == "--slo-ms" && has_value) {
+            options.slo_ms = std::atof(argv[++i]);
+        } else if (arg == "--governance-speedup" && has_value) {
+            options.governance_speedup = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--out" && has_value) {
+            options.out = argv[++i];
+        } else {
+            loadgen::usage(argv[0]);
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+    if (options.threads == 0 || options.users < options.threads || options.assets == 0 ||
+        options.price_rate <= 0 || options.block_seconds <= 0 || options.step_seconds <= 0 ||
+        options.governance_speedup == 0) {
+        std::fprintf(stderr, "Invalid options: need threads >= 1, users >= threads, assets >= 1 and positive rates\n");
+        return 2;
+    }
+    if (options.rates.empty()) {
+        for (uint64_t rate = std::max<uint64_t>(options.start_rate, 1); rate <= options.max_rate; rate *= 2) {
+            options.rates.push_back(rate);
+        }
+    }
+
+    std::vector<loadgen::LoadGenerator::StepResult> steps;
+    try {
+        loadgen::LoadGenerator generator(options);
+        for (uint64_t rate : options.rates) {
+            steps.push_back(generator.step(rate));
+            loadgen::print_step(steps.back());
+            if (steps.back().saturated) break;
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "Load generation failed: %s\n", e.what());
+        return 1;
+    }
+
+    std::string json = loadgen::to_json(options, steps);
+    if (options.out.empty()) {
+        std::fputs(json.c_str(), stdout);
+    } else {
+        FILE* file = std::fopen(options.out.c_str(), "w");
+        if (!file) {
+            std::fprintf(stderr, "Cannot write %s\n", options.out.c_str());
+            return 1;
+        }
+        std::fputs(json.c_str(), file);
+        std::fclose(file);
+    }
+    return 0;
+}
@@ -16,9 +16,11 @@
  */
 
 #include <cstdint>
+#include <fstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include <limits>
 #include <set>
 #include <array>
 #include <algorithm>
@@ -37,6 +39,23 @@
 
 // Include quantum signature verification
 #include "QuantumSignature.hpp"
+#include "EventStore.hpp"
+#include "AddressRegistry.hpp"
+#include "BalanceTable.hpp"
+#include "FlatHashMap.hpp"
+#include "BlockExecutor.hpp"
+#include "LedgerCompactor.hpp"
+#include "StateCommitment.hpp"
+#include "BalanceSnapshots.hpp"
+#include "LedgerTransaction.hpp"
+#include "VolumeLimiter.hpp"
+#include "FixedPoint.hpp"
+#include "SwapNetting.hpp"
+#include "TimingWheel.hpp"
+#include "NonceTable.hpp"
+#include "GovernanceActions.hpp"
+#include "ShardedCounter.hpp"
+#include "ProfiledMutex.hpp"
 
 // ========================== CONSTANTS & CONFIGURATION ==========================
 namespace qOracleConfig {
@@ -60,23 +79,44 @@ namespace qOracleConfig {
     constexpr uint64_t QBTC_TOTAL_SUPPLY = 2100000000000000; // 21M BTC in satoshis
     
     constexpr uint64_t QUSD_DECIMALS = 15;
-    constexpr uint64_t QUSD_DECIMAL_MULTIPLIER = 1000000000000000ULL;
+    constexpr uint64_t QUSD_DECIMAL_MULTIPLIER = qOracle::pow10(QUSD_DECIMALS);
     
     // Bridge Configuration
     constexpr uint64_t BRIDGE_FEE = 0; // Zero fees for trustless operation
     constexpr uint64_t MIN_SWAP_AMOUNT = 1000; // Minimum swap amount
     constexpr uint64_t MAX_DAILY_VOLUME = 1000000000000000ULL; // 1M STX equivalent
+    constexpr uint64_t MAX_ACCOUNT_DAILY_VOLUME = MAX_DAILY_VOLUME / 10; // No account takes over 10% of the window
+    constexpr uint64_t VOLUME_WINDOW = 86400;   // Sliding 24 hours
+    constexpr uint64_t VOLUME_BUCKET = 60;      // One-minute buckets
+    constexpr uint64_t SWAP_NETTING_EPOCH = 5;  // Seconds of swaps gathered per netted settlement
     
     // Security Configuration
     constexpr uint64_t EMERGENCY_PAUSE_THRESHOLD = 3; // Failed updates before pause
     constexpr uint64_t ORACLE_ROTATION_INTERVAL = 86400; // 24 hours
     constexpr uint64_t PRICE_UPDATE_TIMEOUT = 300; // 5 minutes
+    
+    // Governance Configuration
+    constexpr uint64_t GOVERNANCE_EXECUTION_DELAY = 86400;  // 24 hours before a proposal may execute
+    constexpr uint64_t PROPOSAL_DURATION = 604800;          // 7 days from creation until expiry
+    constexpr bool GOVERNANCE_AUTO_EXECUTE = false;         // Execute ready proposals on tick()
+    constexpr const char* GOVERNANCE_ACCOUNT = "QNOSIS_GOVERNANCE"; // Sender for executed governance actions
+    
+    // Ledger Configuration
+    constexpr qOracle::LedgerMode LEDGER_MODE = qOracle::LedgerMode::Striped; // LockFree for hot-account workloads
+    constexpr uint64_t LEDGER_COMPACTION_INTERVAL = 600; // 10 minutes between zero-chunk sweeps
+    constexpr size_t SNAPSHOT_RETENTION = 256;           // Committed epochs readable through at_epoch()
+    constexpr size_t BLOCK_PARALLEL_WAVES = 4;           // Speculative waves before a block finishes serially
+    
+    // Block execution token indices (BlockTx::token)
+    constexpr uint8_t TOKEN_BKPY = 0;
+    constexpr uint8_t TOKEN_QBTC = 1;
+    constexpr uint8_t TOKEN_QUSD = 2;
 }
 
 // ========================== THREAD-SAFE LOGGING ==========================
 class ThreadSafeLogger {
 private:
-    std::mutex log_mutex;
+    qOracle::ProfiledMutex log_mutex{"logger"};
     std::ofstream log_file;
     
 public:
@@ -85,7 +125,7 @@ public:
     }
     
     void log(const std::string& level, const std::string& message) {
-        std::lock_guard<std::mutex> lock(log_mutex);
+        std::lock_guard<qOracle::ProfiledMutex> lock(log_mutex);
         auto now = std::chrono::system_clock::now();
         auto time_t = std::chrono::system_clock::to_time_t(now);
         
@@ -103,54 +143,149 @@ public:
 // ========================== LAUNCH PROTECTION ==========================
 class LaunchProtect {
 protected:
-    std::atomic<bool> initialized{false};
-    std::atomic<bool> burned{false};
-    std::string admin;
+    // Launch state packed into one word. Once finalized, requireActive()
+    // is a single relaxed load tested against the lifecycle bits, whatever
+    // GOVERNED says; everything else (launch phase, burned key, bad
+    // sender) takes the cold path.
+    static constexpr uint32_t INITIALIZED = 1u << 0;
+    static constexpr uint32_t BURNED = 1u << 1;
+    static constexpr uint32_t GOVERNED = 1u << 2;   // governance is bound and immutable
+    
+    static constexpr bool finalized(uint32_t s) { return (s & (INITIALIZED | BURNED)) == INITIALIZED; }
+    
+    std::atomic<uint32_t> state{0};
+    const std::string admin;                        // Never written after construction
+    const uint64_t admin_fingerprint;
+    qOracle::AccountId admin_account = qOracle::INVALID_ACCOUNT;
+    std::string governance;                         // Written once, before GOVERNED is published
+    uint64_t governance_fingerprint = 0;
     std::shared_ptr<ThreadSafeLogger> logger;
+    std::shared_ptr<qOracle::EventStore> events;
     
     LaunchProtect(const std::string& admin_address, std::shared_ptr<ThreadSafeLogger> log)
-        : admin(admin_address), logger(log) {
+        : admin(admin_address), admin_fingerprint(fingerprint(admin_address)), logger(log) {
         logger->info("LaunchProtect initialized for admin: " + admin_address);
     }
 
+    // Length and the first and last eight bytes: rejects almost every
+    // non-matching address without walking the whole string
+    static uint64_t fingerprint(const std::string& address) {
+        uint64_t head = 0, tail = 0;
+        size_t n = address.size();
+        std::memcpy(&head, address.data(), n < 8 ? n : 8);
+        if (n > 8) std::memcpy(&tail, address.data() + (n < 16 ? 8 : n - 8), n < 16 ? n - 8 : 8);
+        return (head * 0x9E3779B97F4A7C15ULL) ^ (tail + 0x632BE59BD9B4E019ULL) ^ (uint64_t(n) << 56);
+    }
+
+    bool isAdmin(const std::string& sender) const {
+        return fingerprint(sender) == admin_fingerprint && sender == admin;
+    }
+
+    bool isGovernance(const std::string& sender, uint32_t s) const {
+        return (s & GOVERNED) && fingerprint(sender) == governance_fingerprint && sender == governance;
+    }
+
+    // Record an indexer event if an event store is attached
+    void emitEvent(qOracle::EventType type, const std::string& asset, const std::string& from,
+                   const std::string& to, uint64_t amount, uint64_t aux = 0, uint8_t detail = 0) const {
+        if (!events) return;
+        uint64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        events->append(type, now, asset, from, to, amount, aux, detail);
+    }
+
     void requireActive(const std::string& sender) const {
-        if (!initialized.load() && sender != admin) {
-            logger->security("Unauthorized access attempt by: " + sender);
-            throw std::runtime_error("Contract not initialized");
-        }
-        if (burned.load()) {
-            logger->security("Contract immutable - admin key burned");
-            throw std::runtime_error("Admin key burned - contract immutable");
-        }
+        static_assert(finalized(INITIALIZED) && finalized(INITIALIZED | GOVERNED) && !finalized(GOVERNED) &&
+                      !finalized(INITIALIZED | BURNED) && !finalized(0), "Governed contracts take the fast path");
+        uint32_t s = state.load(std::memory_order_relaxed);
+        if (__builtin_expect(finalized(s), 1)) return;
+        requireActiveSlow(s, isAdmin(sender), [&] { return sender; });
+    }
+
+    // Interned-id variant for ledgers that resolved admin_account
+    void requireActive(qOracle::AccountId sender) const {
+        uint32_t s = state.load(std::memory_order_relaxed);
+        if (__builtin_expect(finalized(s), 1)) return;
+        requireActiveSlow(s, sender == admin_account, [&] { return "account " + std::to_string(sender); });
     }
 
     void requireAdmin(const std::string& sender) const {
-        if (sender != admin) {
+        if (!isAdmin(sender)) {
             logger->security("Admin access required, attempted by: " + sender);
             throw std::runtime_error("Admin access required");
         }
-        if (burned.load()) {
+        if (state.load() & BURNED) {
             logger->security("Admin key already burned");
             throw std::runtime_error("Admin key burned - contract immutable");
         }
     }
 
+    // Governed settings accept the bound governance sender, or the admin
+    // until the key is burned
+    void requireGovernance(const std::string& sender) const {
+        uint32_t s = state.load(std::memory_order_acquire);
+        if (isGovernance(sender, s)) return;
+        if (!(s & BURNED) && isAdmin(sender)) return;
+        logger->security("Governance access required, attempted by: " + sender);
+        throw std::runtime_error("Governance access required");
+    }
+
+public:
+    // Lifecycle calls are made by the deploying system on each component
+
+    // Bind the governance sender; once only, so readers never see it change
+    void setGovernance(const std::string& sender, const std::string& address) {
+        requireAdmin(sender);
+        if (state.load() & GOVERNED) throw std::runtime_error("Governance already bound");
+        governance = address;
+        governance_fingerprint = fingerprint(address);
+        state.fetch_or(GOVERNED, std::memory_order_release);
+        logger->info("Governance bound to: " + address);
+    }
+
     void finalizeLaunch(const std::string& sender) {
         requireAdmin(sender);
-        initialized.store(true);
+        state.fetch_or(INITIALIZED);
         logger->info("Launch finalized by: " + sender);
     }
 
+    // The admin string stays as constructed; the BURNED bit alone revokes it
     void burnKey(const std::string& sender) {
         requireAdmin(sender);
-        burned.store(true);
-        admin = "0x000000000000000000000000000000000000dead";
+        state.fetch_or(BURNED);
         logger->security("Admin key burned by: " + sender);
     }
 
-    bool isInitialized() const { return initialized.load(); }
-    bool isKeyBurned() const { return burned.load(); }
-    std::string adminAddress() const { return admin; }
+    bool isInitialized() const { return state.load() & INITIALIZED; }
+    bool isKeyBurned() const { return state.load() & BURNED; }
+    std::string adminAddress() const {
+        return isKeyBurned() ? "0x000000000000000000000000000000000000dead" : admin;
+    }
+
+protected:
+    // Non-throwing requireActive for pre-screening block transactions
+    bool isActiveFor(qOracle::AccountId sender) const {
+        uint32_t s = state.load(std::memory_order_relaxed);
+        return finalized(s) || (!(s & BURNED) && sender == admin_account);
+    }
+
+private:
+    // Launch phase or burned key; only the failures build log strings
+    template <typename Name>
+    [[gnu::noinline, gnu::cold]]
+    void requireActiveSlow(uint32_t s, bool is_admin, Name name) const {
+        if (!(s & INITIALIZED) && !is_admin) {
+            logger->security("Unauthorized access attempt by " + name());
+            throw std::runtime_error("Contract not initialized");
+        }
+        if (s & BURNED) {
+            logger->security("Contract immutable - admin key burned");
+            throw std::runtime_error("Admin key burned - contract immutable");
+        }
+    }
+
+public:
+    void attachEventStore(std::shared_ptr<qOracle::EventStore> store) { events = store; }
 };
 
 // ========================== ORACLE COMMITTEE ==========================
@@ -159,11 +294,13 @@ private:
     std::unique_ptr<qOracle::QuantumSignatureVerifier> verifier;
     std::unique_ptr<qOracle::PriceValidator> validator;
     qOracle::PriceMessage last_price;
+    qOracle::VerifiedPrice last_attestation;
     std::vector<qOracle::PriceMessage> price_history;
-    std::mutex price_mutex;
+    mutable qOracle::ProfiledMutex price_mutex{"committee.price"};
+    // Read without price_mutex on every update and swap; keep them off its line
+    alignas(qOracle::CACHE_LINE_SIZE) std::atomic<bool> emergency_paused{false};
     std::atomic<uint64_t> failed_updates{0};
-    std::atomic<bool> emergency_paused{false};
-    size_t max_history = 1024;
+    alignas(qOracle::CACHE_LINE_SIZE) size_t max_history = 1024;
     
     // Oracle performance tracking
     struct OraclePerformance {
@@ -199,7 +336,7 @@ public:
             return false;
         }
         
-        std::lock_guard<std::mutex> lock(price_mutex);
+        std::lock_guard<qOracle::ProfiledMutex> lock(price_mutex);
         
         // Validate price update
         if (!validator->validate_price_update(update.message, get_current_block_timestamp(), last_price.price)) {
@@ -208,8 +345,9 @@ public:
             return false;
         }
         
-        // Verify quantum signatures
-        if (!verifier->verify_price_update(update)) {
+        // Verify quantum signatures once; consumers share the attestation
+        qOracle::VerifiedPrice attestation = verifier->attest_price_update(update);
+        if (!attestation) {
             logger->warn("Price update signature verification failed");
             failed_updates.fetch_add(1);
             return false;
@@ -217,6 +355,7 @@ public:
         
         // Update price history
         last_price = update.message;
+        last_attestation = std::move(attestation);
         price_history.push_back(last_price);
         
         // Maintain history size
@@ -234,6 +373,7 @@ public:
         
         logger->info("Price update accepted: " + std::to_string(last_price.price) + 
                     " for " + last_price.asset + " at " + std::to_string(last_price.timestamp));
+        emitEvent(qOracle::EventType::PriceUpdated, last_price.asset, "", "", last_price.price, last_price.nonce);
         
         // Reset failed updates counter on success
         failed_updates.store(0);
@@ -242,10 +382,21 @@ public:
     }
 
     qOracle::PriceMessage get_current_price() const { 
-        std::lock_guard<std::mutex> lock(price_mutex);
+        std::lock_guard<qOracle::ProfiledMutex> lock(price_mutex);
         return last_price; 
     }
 
+    // Attestation for the latest accepted update; empty before the first
+    qOracle::VerifiedPrice verified_price() const {
+        std::lock_guard<qOracle::ProfiledMutex> lock(price_mutex);
+        return last_attestation;
+    }
+
+    // True if this committee's verifier issued the attestation
+    bool issued(const qOracle::VerifiedPrice& price) const {
+        return price.valid() && price.issuer() == verifier.get();
+    }
+
     bool emergency_pause(const std::string& sender) {
         requireAdmin(sender);
         emergency_paused.store(true);
@@ -262,6 +413,26 @@ public:
     
     bool is_emergency_paused() const { return emergency_paused.load(); }
     
+    // Governance-driven pause and resume
+    bool set_emergency_pause(const std::string& sender, bool paused) {
+        requireGovernance(sender);
+        emergency_paused.store(paused);
+        logger->security(std::string("Emergency pause ") + (paused ? "activated" : "lifted") + " by: " + sender);
+        return true;
+    }
+    
+    // Take an oracle out of (or back into) the signing set
+    bool set_oracle_active(const std::string& sender, size_t index, bool active) {
+        requireGovernance(sender);
+        if (index >= qOracleConfig::NUM_ORACLES) return false;
+        std::lock_guard<qOracle::ProfiledMutex> lock(price_mutex);
+        if (active) verifier->activate_oracle(index);
+        else verifier->deactivate_oracle(index);
+        oracle_performance[index].active = active;
+        logger->security("Oracle " + std::to_string(index) + (active ? " activated" : " deactivated") + " by: " + sender);
+        return true;
+    }
+    
     uint64_t get_failed_updates() const { return failed_updates.load(); }
     
     std::vector<OraclePerformance> get_oracle_performance() const {
@@ -275,255 +446,483 @@ private:
     }
 };
 
-// ========================== BANKON PYTHAI TOKEN ==========================
-class BankonPythaiToken : public LaunchProtect {
+// ========================== TOKEN LEDGER ==========================
+// Who may create and destroy units of a token
+enum class MintAuthority : uint8_t {
+    Genesis,    // Whole supply minted once to the admin; holders burn their own
+    Oracle,     // Holders mint against a fresh committee price and burn their own
+    Bridge      // Only the bridge authority mints and burns
+};
+
+// Compile-time token parameters consumed by Ledger<Policy>
+struct BkpyPolicy {
+    static constexpr const char* SYMBOL = "BKPY";
+    static constexpr const char* NAME = "BANKON PYTHAI";
+    static constexpr uint64_t DECIMALS = qOracleConfig::BKPY_DECIMALS;
+    static constexpr MintAuthority MINT = MintAuthority::Genesis;
+    static constexpr bool FIXED_SUPPLY = true;
+    static constexpr uint64_t TOTAL_SUPPLY = qOracleConfig::BKPY_TOTAL_SUPPLY;
+    static constexpr bool LOG_TRANSFERS = true;
+};
+
+struct QbtcPolicy {
+    static constexpr const char* SYMBOL = "qBTC";
+    static constexpr const char* NAME = "Synthetic Bitcoin";
+    static constexpr uint64_t DECIMALS = qOracleConfig::QBTC_DECIMALS;
+    static constexpr MintAuthority MINT = MintAuthority::Oracle;
+    static constexpr bool FIXED_SUPPLY = false;
+    static constexpr bool LOG_TRANSFERS = true;
+};
+
+struct QusdPolicy {
+    static constexpr const char* SYMBOL = "qUSD";
+    static constexpr const char* NAME = "Synthetic USDC";
+    static constexpr uint64_t DECIMALS = qOracleConfig::QUSD_DECIMALS;
+    static constexpr MintAuthority MINT = MintAuthority::Bridge;
+    static constexpr bool FIXED_SUPPLY = false;
+    static constexpr bool LOG_TRANSFERS = true;
+};
+
+// Read-only ledger state at one committed epoch; holds the epoch pinned
+class LedgerView {
 private:
-    std::unordered_map<std::string, uint64_t> balances;
-    std::atomic<bool> minted{false};
-    std::mutex balance_mutex;
-    
+    qOracle::BalanceSnapshots::Snapshot snapshot;
+    std::shared_ptr<qOracle::AddressRegistry> registry;
+
 public:
-    BankonPythaiToken(const std::string& deployer, std::shared_ptr<ThreadSafeLogger> log) 
-        : LaunchProtect(deployer, log) {}
+    LedgerView(qOracle::BalanceSnapshots::Snapshot snap, std::shared_ptr<qOracle::AddressRegistry> reg)
+        : snapshot(std::move(snap)), registry(reg) {}
 
-    bool mint_initial_supply(const std::string& sender) {
-        requireAdmin(sender);
-        
-        if (minted.load()) {
-            logger->warn("Initial supply already minted");
+    // False if the epoch is not yet committed or has been reclaimed
+    bool valid() const { return snapshot.valid(); }
+    uint64_t epoch() const { return snapshot.epoch(); }
+
+    uint64_t balanceOf(const std::string& addr) const { return snapshot.balanceOf(registry->find(addr)); }
+    uint64_t balanceOf(qOracle::AccountId id) const { return snapshot.balanceOf(id); }
+
+    // fn(AccountId, uint64_t) for every funded account, in id order
+    template <typename Fn>
+    void for_each(Fn fn) const { snapshot.for_each(fn); }
+};
+
+// Balance, transfer, burn and batch logic shared by every token. Policy
+// decides decimals, supply rules, mint authority and per-transfer logging
+// at compile time; tokens add only their own mint entry points.
+template <typename Policy>
+class Ledger : public LaunchProtect {
+public:
+    static_assert(Policy::DECIMALS <= qOracle::MAX_DECIMALS, "Token unit must fit in 64 bits");
+    static constexpr uint64_t DECIMALS = Policy::DECIMALS;
+    static constexpr uint64_t UNIT = qOracle::pow10(DECIMALS);
+    static constexpr uint64_t MAX_WHOLE_TOKENS = std::numeric_limits<uint64_t>::max() / UNIT;
+
+    static constexpr uint64_t to_units(uint64_t whole) { return whole * UNIT; }
+    static constexpr uint64_t whole_part(uint64_t amount) { return amount / UNIT; }
+    static constexpr uint64_t fraction_part(uint64_t amount) { return amount % UNIT; }
+
+    // Base units rendered as a decimal string, e.g. 150000000 qBTC -> "1.50000000"
+    static std::string format_amount(uint64_t amount) {
+        std::string out = std::to_string(whole_part(amount));
+        if constexpr (DECIMALS > 0) {
+            std::string frac = std::to_string(fraction_part(amount));
+            out += "." + std::string(DECIMALS - frac.size(), '0') + frac;
+        }
+        return out;
+    }
+
+protected:
+    std::shared_ptr<qOracle::AddressRegistry> registry;
+    qOracle::BalanceTable balances;
+    qOracle::ShardedCounter total_supply;                   // Per-thread cells; mints and burns never share a line
+    std::string authority;                                  // Bridge mint/burn authority
+    qOracle::AccountId authority_account = qOracle::INVALID_ACCOUNT;
+    qOracle::SparseMerkleTree commitment;
+    qOracle::BalanceSnapshots snapshots{qOracleConfig::SNAPSHOT_RETENTION};
+    qOracle::ProfiledMutex commit_mutex{"ledger.commit"};   // Drain and apply changes in order
+
+    Ledger(const std::string& deployer, std::shared_ptr<qOracle::AddressRegistry> reg,
+           std::shared_ptr<ThreadSafeLogger> log, qOracle::LedgerMode mode)
+        : LaunchProtect(deployer, log), registry(reg), balances(mode, true) {
+        admin_account = registry->intern(deployer);
+    }
+
+    // Ids reach the ledger from callers and blocks; only registered ones may be credited
+    bool known(qOracle::AccountId id) const { return registry->contains(id); }
+
+    // Credit newly created units; callers have already checked mint authority
+    bool mint_units(qOracle::AccountId to, uint64_t amount) {
+        if (amount == 0) return false;
+        if (!known(to)) {
+            logger->warn(std::string(Policy::SYMBOL) + " mint to unregistered account " + std::to_string(to));
             return false;
         }
         
-        std::lock_guard<std::mutex> lock(balance_mutex);
-        balances[sender] = qOracleConfig::BKPY_TOTAL_SUPPLY;
-        minted.store(true);
+        balances.credit(to, amount);
+        total_supply.add(amount);
+        record_mint(to, amount);
+        return true;
+    }
+
+    bool burn_units(qOracle::AccountId from, uint64_t amount) {
+        if (amount == 0) return false;
         
-        logger->info("Initial BKPY supply minted to: " + sender);
+        if (!balances.debit(from, amount)) {
+            logger->warn("Insufficient " + std::string(Policy::SYMBOL) + " balance for burn from: " +
+                        registry->address(from));
+            return false;
+        }
+        // Fixed-supply tokens report their configured supply regardless of burns
+        if constexpr (!Policy::FIXED_SUPPLY) total_supply.sub(amount);
+        record_burn(from, amount);
         return true;
     }
 
+public:
+    // Launch checks for operations staged through a LedgerTransaction
+    void authorize(const std::string& sender) const { requireActive(sender); }
+
+    // Log and index a mint or burn, however it was applied
+    void record_mint(qOracle::AccountId to, uint64_t amount) const {
+        std::string addr = registry->address(to);
+        logger->info(std::string(Policy::SYMBOL) + " minted: " + std::to_string(amount) + " to " + addr);
+        emitEvent(qOracle::EventType::Mint, Policy::SYMBOL, "", addr, amount);
+    }
+
+    void record_burn(qOracle::AccountId from, uint64_t amount) const {
+        std::string addr = registry->address(from);
+        logger->info(std::string(Policy::SYMBOL) + " burned: " + std::to_string(amount) + " from " + addr);
+        emitEvent(qOracle::EventType::Burn, Policy::SYMBOL, addr, "", amount);
+    }
+
     bool transfer(const std::string& sender, const std::string& to, uint64_t amount) {
         requireActive(sender);
         
-        if (amount == 0) return false;
-        
-        std::lock_guard<std::mutex> lock(balance_mutex);
-        
-        if (balances[sender] < amount) {
-            logger->warn("Insufficient balance for transfer from: " + sender);
+        // Reject before interning so failed transfers never register the recipient
+        qOracle::AccountId from_id = registry->find(sender);
+        if (from_id == qOracle::INVALID_ACCOUNT || amount == 0 || balances.get(from_id) < amount) {
+            logger->warn("Insufficient " + std::string(Policy::SYMBOL) + " balance for transfer from: " + sender);
             return false;
         }
-        
-        balances[sender] -= amount;
-        balances[to] += amount;
-        
-        logger->info("BKPY transfer: " + std::to_string(amount) + " from " + sender + " to " + to);
-        return true;
+        return transfer(from_id, registry->intern(to), amount);
     }
 
-    bool burn(const std::string& sender, uint64_t amount) {
+    bool transfer(qOracle::AccountId sender, qOracle::AccountId to, uint64_t amount) {
         requireActive(sender);
         
         if (amount == 0) return false;
-        
-        std::lock_guard<std::mutex> lock(balance_mutex);
-        
-        if (balances[sender] < amount) {
-            logger->warn("Insufficient balance for burn from: " + sender);
+        if (!known(to)) {
+            logger->warn(std::string(Policy::SYMBOL) + " transfer to unregistered account " + std::to_string(to));
             return false;
         }
         
-        balances[sender] -= amount;
-        // Burned tokens are removed from total supply
+        if (!balances.transfer(sender, to, amount)) {
+            logger->warn("Insufficient " + std::string(Policy::SYMBOL) + " balance for transfer from: " +
+                        registry->address(sender));
+            return false;
+        }
         
-        logger->info("BKPY burn: " + std::to_string(amount) + " from " + sender);
+        // Address strings are only needed for the log line and the indexer
+        if (Policy::LOG_TRANSFERS || events) {
+            std::string from_addr = registry->address(sender);
+            std::string to_addr = registry->address(to);
+            if constexpr (Policy::LOG_TRANSFERS) {
+                logger->info(std::string(Policy::SYMBOL) + " transfer: " + std::to_string(amount) +
+                            " from " + from_addr + " to " + to_addr);
+            }
+            emitEvent(qOracle::EventType::Transfer, Policy::SYMBOL, from_addr, to_addr, amount);
+        }
         return true;
     }
 
-    uint64_t balanceOf(const std::string& addr) const {
-        std::lock_guard<std::mutex> lock(balance_mutex);
-        auto it = balances.find(addr);
-        return it != balances.end() ? it->second : 0;
+    // Holder burns from their own balance (Genesis and Oracle tokens)
+    bool burn(const std::string& sender, uint64_t amount) {
+        static_assert(Policy::MINT != MintAuthority::Bridge, "Bridge tokens burn through burn(sender, from, amount)");
+        requireActive(sender);
+        
+        qOracle::AccountId id = registry->find(sender);
+        if (id == qOracle::INVALID_ACCOUNT) {
+            logger->warn("Insufficient " + std::string(Policy::SYMBOL) + " balance for burn from: " + sender);
+            return false;
+        }
+        return burn(id, amount);
     }
 
-    uint64_t totalSupply() const { return qOracleConfig::BKPY_TOTAL_SUPPLY; }
-    std::string symbol() const { return "BKPY"; }
-    std::string name() const { return "BANKON PYTHAI"; }
-    uint64_t decimals() const { return qOracleConfig::BKPY_DECIMALS; }
-};
-
-// ========================== QBTC SYNTHETIC TOKEN ==========================
-class QBTCSynthetic : public LaunchProtect {
-private:
-    std::unordered_map<std::string, uint64_t> balances;
-    std::atomic<uint64_t> total_supply{0};
-    std::mutex balance_mutex;
-    QOracleCommittee& oracle;
-    
-public:
-    QBTCSynthetic(const std::string& deployer, QOracleCommittee& _oracle, std::shared_ptr<ThreadSafeLogger> log) 
-        : LaunchProtect(deployer, log), oracle(_oracle) {}
+    bool burn(qOracle::AccountId sender, uint64_t amount) {
+        static_assert(Policy::MINT != MintAuthority::Bridge, "Bridge tokens burn through burn(sender, from, amount)");
+        requireActive(sender);
+        return burn_units(sender, amount);
+    }
 
-    bool mint(const std::string& user, uint64_t btc_sats, const qOracle::PriceUpdate& price_update) {
-        requireActive(user);
+    // Bridge authority mints and burns on behalf of users (Bridge tokens)
+    bool mint(const std::string& sender, const std::string& to, uint64_t amount) {
+        static_assert(Policy::MINT == MintAuthority::Bridge, "Only bridge tokens mint by authority");
+        requireActive(sender);
         
-        if (oracle.is_emergency_paused()) {
-            logger->warn("Minting rejected - oracle system paused");
+        if (sender != authority) {
+            logger->warn("Unauthorized " + std::string(Policy::SYMBOL) + " mint attempt by: " + sender);
             return false;
         }
+        return mint(authority_account, registry->intern(to), amount);
+    }
+
+    bool mint(qOracle::AccountId sender, qOracle::AccountId to, uint64_t amount) {
+        static_assert(Policy::MINT == MintAuthority::Bridge, "Only bridge tokens mint by authority");
+        requireActive(sender);
         
-        if (btc_sats == 0) return false;
-        
-        // Verify price update is recent
-        auto current_price = oracle.get_current_price();
-        if (price_update.message.timestamp < current_price.timestamp - qOracleConfig::PRICE_UPDATE_TIMEOUT) {
-            logger->warn("Price update too old for minting");
+        if (sender != authority_account) {
+            logger->warn("Unauthorized " + std::string(Policy::SYMBOL) + " mint attempt by: " + registry->address(sender));
             return false;
         }
-        
-        std::lock_guard<std::mutex> lock(balance_mutex);
-        balances[user] += btc_sats;
-        total_supply.fetch_add(btc_sats);
-        
-        logger->info("qBTC minted: " + std::to_string(btc_sats) + " to " + user);
-        return true;
+        return mint_units(to, amount);
     }
 
-    bool burn(const std::string& user, uint64_t amount) {
-        requireActive(user);
-        
-        if (amount == 0) return false;
-        
-        std::lock_guard<std::mutex> lock(balance_mutex);
+    bool burn(const std::string& sender, const std::string& from, uint64_t amount) {
+        static_assert(Policy::MINT == MintAuthority::Bridge, "Only bridge tokens burn by authority");
+        requireActive(sender);
         
-        if (balances[user] < amount) {
-            logger->warn("Insufficient qBTC balance for burn from: " + user);
+        if (sender != authority) {
+            logger->warn("Unauthorized " + std::string(Policy::SYMBOL) + " burn attempt by: " + sender);
             return false;
         }
         
-        balances[user] -= amount;
-        total_supply.fetch_sub(amount);
-        
-        logger->info("qBTC burned: " + std::to_string(amount) + " from " + user);
-        return true;
+        qOracle::AccountId from_id = registry->find(from);
+        if (from_id == qOracle::INVALID_ACCOUNT) {
+            logger->warn("Insufficient " + std::string(Policy::SYMBOL) + " balance for burn from: " + from);
+            return false;
+        }
+        return burn(authority_account, from_id, amount);
     }
 
-    bool transfer(const std::string& sender, const std::string& to, uint64_t amount) {
+    bool burn(qOracle::AccountId sender, qOracle::AccountId from, uint64_t amount) {
+        static_assert(Policy::MINT == MintAuthority::Bridge, "Only bridge tokens burn by authority");
         requireActive(sender);
         
-        if (amount == 0) return false;
-        
-        std::lock_guard<std::mutex> lock(balance_mutex);
-        
-        if (balances[sender] < amount) {
-            logger->warn("Insufficient qBTC balance for transfer from: " + sender);
+        if (sender != authority_account) {
+            logger->warn("Unauthorized " + std::string(Policy::SYMBOL) + " burn attempt by: " + registry->address(sender));
             return false;
         }
+        return burn_units(from, amount);
+    }
+
+    // Pay many recipients from one sender under a single pass over the shard locks
+    qOracle::BatchResult transfer_batch(qOracle::AccountId sender, const std::vector<qOracle::TransferLeg>& legs,
+                                        qOracle::BatchMode mode = qOracle::BatchMode::AllOrNothing) {
+        requireActive(sender);
         
-        balances[sender] -= amount;
-        balances[to] += amount;
-        
-        logger->info("qBTC transfer: " + std::to_string(amount) + " from " + sender + " to " + to);
-        return true;
+        std::vector<qOracle::TransferOrder> orders;
+        orders.reserve(legs.size());
+        for (const auto& leg : legs) orders.push_back({sender, leg.to, leg.amount});
+        return settle_batch(std::move(orders), mode, sender);
+    }
+
+    qOracle::BatchResult multi_transfer(const std::vector<qOracle::TransferOrder>& orders,
+                                        qOracle::BatchMode mode = qOracle::BatchMode::AllOrNothing) {
+        for (const auto& order : orders) requireActive(order.from);
+        return settle_batch(orders, mode, qOracle::INVALID_ACCOUNT);
     }
 
     uint64_t balanceOf(const std::string& addr) const {
-        std::lock_guard<std::mutex> lock(balance_mutex);
-        auto it = balances.find(addr);
-        return it != balances.end() ? it->second : 0;
+        return balanceOf(registry->find(addr));
     }
 
-    uint64_t totalSupply() const { return total_supply.load(); }
-    std::string symbol() const { return "qBTC"; }
-    std::string name() const { return "Synthetic Bitcoin"; }
-    uint64_t decimals() const { return qOracleConfig::QBTC_DECIMALS; }
+    uint64_t balanceOf(qOracle::AccountId id) const {
+        return balances.get(id);
+    }
 
-    qOracle::PriceMessage getCurrentPrice() const { return oracle.get_current_price(); }
+    // Block executor hooks: fixed supply has no counter to adjust
+    qOracle::BlockLedger block_ledger() {
+        return {&balances, Policy::FIXED_SUPPLY ? nullptr : &total_supply};
+    }
+    qOracle::LedgerStats ledger_stats() const { return balances.stats(); }
+
+    // Fold every balance written since the last commit into the Merkle
+    // tree and publish it as the next snapshot epoch. Holding all stripes
+    // gives a consistent cut in Striped mode; in LockFree mode quiesce
+    // transfers first.
+    uint64_t commit_epoch(qOracle::WorkerPool* pool = nullptr) {
+        std::lock_guard<qOracle::ProfiledMutex> lock(commit_mutex);
+        std::vector<std::pair<qOracle::AccountId, uint64_t>> changes;
+        {
+            auto guard = balances.lock_shards(~uint64_t(0));
+            balances.drain_changes(changes);
+        }
+        commitment.update(changes, pool);
+        return snapshots.publish(changes);
+    }
+
+    // Root and proofs describe the last committed epoch
+    qOracle::StateHash state_root() const { return commitment.root(); }
+    qOracle::InclusionProof prove_balance(qOracle::AccountId id) const { return commitment.prove(id); }
+    qOracle::InclusionProof prove_balance(const std::string& addr) const {
+        return prove_balance(registry->find(addr));
+    }
+
+    // Non-blocking reads of committed state; writers never wait on these
+    LedgerView at_epoch(uint64_t epoch) const { return LedgerView(snapshots.at_epoch(epoch), registry); }
+    LedgerView snapshot() const { return LedgerView(snapshots.latest(), registry); }
+    uint64_t current_epoch() const { return snapshots.latest_epoch(); }
+
+    // Epochs kept readable through at_epoch(); each costs the trie nodes
+    // its commit replaced, so deep history trades memory for reach
+    void set_snapshot_retention(const std::string& sender, size_t epochs) {
+        requireAdmin(sender);
+        snapshots.set_retention(epochs);
+        logger->info(std::string(Policy::SYMBOL) + " snapshot retention set to " +
+                    std::to_string(snapshots.retained()) + " epochs by: " + sender);
+    }
+    size_t snapshot_retention() const { return snapshots.retained(); }
+    size_t snapshot_nodes() const { return snapshots.node_count(); }
+    size_t snapshot_bytes() const { return snapshots.memory_bytes(); }
+
+    // Transfers and holder burns act for the sender. Only bridge tokens mint
+    // in a block: Genesis tokens never mint, and Oracle mints need a price
+    // attestation that a BlockTx does not carry
+    bool admits(const qOracle::BlockTx& tx) const {
+        if (!isActiveFor(tx.sender)) return false;
+        if (tx.kind != qOracle::TxKind::Mint && !known(tx.from)) return false;
+        if (tx.kind != qOracle::TxKind::Burn && !known(tx.to)) return false;
+        switch (tx.kind) {
+            case qOracle::TxKind::Transfer:
+                return tx.sender == tx.from;
+            case qOracle::TxKind::Mint:
+                if constexpr (Policy::MINT == MintAuthority::Bridge) return tx.sender == authority_account;
+                else return false;
+            case qOracle::TxKind::Burn:
+                if constexpr (Policy::MINT == MintAuthority::Bridge) return tx.sender == authority_account;
+                else return tx.sender == tx.from;
+        }
+        return false;
+    }
+
+    uint64_t totalSupply() const {
+        if constexpr (Policy::FIXED_SUPPLY) return Policy::TOTAL_SUPPLY;
+        else return total_supply.load();
+    }
+
+    // Supply at one instant, for invariant checks that run alongside writers
+    uint64_t totalSupplyExact() const {
+        if constexpr (Policy::FIXED_SUPPLY) return Policy::TOTAL_SUPPLY;
+        else return total_supply.load_exact();
+    }
+    std::string symbol() const { return Policy::SYMBOL; }
+    std::string name() const { return Policy::NAME; }
+    uint64_t decimals() const { return DECIMALS; }
+
+private:
+    // Orders naming an unregistered account fail like any other bad order
+    qOracle::BatchResult settle_batch(std::vector<qOracle::TransferOrder> orders, qOracle::BatchMode mode,
+                                      qOracle::AccountId sender_id) {
+        for (auto& order : orders) {
+            if (!known(order.from)) order.from = qOracle::INVALID_ACCOUNT;
+            if (!known(order.to)) order.to = qOracle::INVALID_ACCOUNT;
+        }
+        auto result = balances.apply_batch(orders, mode);
+        if (result.applied == 0) {
+            logger->warn(std::string(Policy::SYMBOL) + " batch rejected: " + std::to_string(orders.size()) + " transfers");
+            return result;
+        }
+        
+        std::string sender = sender_id == qOracle::INVALID_ACCOUNT ? "" : registry->address(sender_id);
+        logger->info(std::string(Policy::SYMBOL) + " batch transfer: " + std::to_string(result.applied) + "/" +
+                    std::to_string(orders.size()) + " transfers, volume " + std::to_string(result.volume) +
+                    (sender.empty() ? "" : " from " + sender));
+        emitEvent(qOracle::EventType::Transfer, Policy::SYMBOL, sender, "", result.volume, result.applied,
+                  qOracle::TRANSFER_BATCH);
+        return result;
+    }
 };
 
-// ========================== QUSD STABLECOIN ==========================
-class QUSDStablecoin : public LaunchProtect {
+// ========================== BANKON PYTHAI TOKEN ==========================
+class BankonPythaiToken : public Ledger<BkpyPolicy> {
 private:
-    std::unordered_map<std::string, uint64_t> balances;
-    std::atomic<uint64_t> total_supply{0};
-    std::mutex balance_mutex;
-    std::string bridge_authority;
+    std::atomic<bool> minted{false};
     
 public:
-    QUSDStablecoin(const std::string& deployer, const std::string& bridge_auth, std::shared_ptr<ThreadSafeLogger> log) 
-        : LaunchProtect(deployer, log), bridge_authority(bridge_auth) {}
+    BankonPythaiToken(const std::string& deployer, std::shared_ptr<qOracle::AddressRegistry> reg,
+                      std::shared_ptr<ThreadSafeLogger> log, qOracle::LedgerMode mode = qOracleConfig::LEDGER_MODE) 
+        : Ledger(deployer, reg, log, mode) {}
 
-    bool mint(const std::string& sender, const std::string& to, uint64_t amount) {
-        requireActive(sender);
+    bool mint_initial_supply(const std::string& sender) {
+        requireAdmin(sender);
         
-        if (sender != bridge_authority) {
-            logger->warn("Unauthorized qUSD mint attempt by: " + sender);
+        bool expected = false;
+        if (!minted.compare_exchange_strong(expected, true)) {
+            logger->warn("Initial supply already minted");
             return false;
         }
         
-        if (amount == 0) return false;
-        
-        std::lock_guard<std::mutex> lock(balance_mutex);
-        balances[to] += amount;
-        total_supply.fetch_add(amount);
-        
-        logger->info("qUSD minted: " + std::to_string(amount) + " to " + to);
-        return true;
+        return mint_units(registry->intern(sender), BkpyPolicy::TOTAL_SUPPLY);
     }
+};
 
-    bool burn(const std::string& sender, const std::string& from, uint64_t amount) {
-        requireActive(sender);
-        
-        if (sender != bridge_authority) {
-            logger->warn("Unauthorized qUSD burn attempt by: " + sender);
+// ========================== QBTC SYNTHETIC TOKEN ==========================
+class QBTCSynthetic : public Ledger<QbtcPolicy> {
+private:
+    QOracleCommittee& oracle;
+    
+public:
+    QBTCSynthetic(const std::string& deployer, QOracleCommittee& _oracle,
+                  std::shared_ptr<qOracle::AddressRegistry> reg, std::shared_ptr<ThreadSafeLogger> log,
+                  qOracle::LedgerMode mode = qOracleConfig::LEDGER_MODE) 
+        : Ledger(deployer, reg, log, mode), oracle(_oracle) {}
+
+    // A rejected mint never registers the user
+    bool mint(const std::string& user, uint64_t btc_sats, const qOracle::VerifiedPrice& price) {
+        requireActive(user);
+        if (!mint_allowed(btc_sats, price)) return false;
+        return mint_units(registry->intern(user), btc_sats);
+    }
+
+    bool mint(qOracle::AccountId user, uint64_t btc_sats, const qOracle::VerifiedPrice& price) {
+        requireActive(user);
+        if (!mint_allowed(btc_sats, price)) return false;
+        return mint_units(user, btc_sats);
+    }
+
+    // Oracle and freshness checks shared by direct mints and bridge swaps,
+    // the only paths that mint qBTC. The attestation proves quorum; only
+    // its origin and age are checked.
+    bool mint_allowed(uint64_t btc_sats, const qOracle::VerifiedPrice& price) const {
+        if (oracle.is_emergency_paused()) {
+            logger->warn("Minting rejected - oracle system paused");
             return false;
         }
         
-        if (amount == 0) return false;
-        
-        std::lock_guard<std::mutex> lock(balance_mutex);
+        if (btc_sats == 0) return false;
         
-        if (balances[from] < amount) {
-            logger->warn("Insufficient qUSD balance for burn from: " + from);
+        if (!oracle.issued(price)) {
+            logger->warn("Minting rejected - price not attested by the committee");
             return false;
         }
         
-        balances[from] -= amount;
-        total_supply.fetch_sub(amount);
-        
-        logger->info("qUSD burned: " + std::to_string(amount) + " from " + from);
-        return true;
-    }
-
-    bool transfer(const std::string& sender, const std::string& to, uint64_t amount) {
-        requireActive(sender);
-        
-        if (amount == 0) return false;
-        
-        std::lock_guard<std::mutex> lock(balance_mutex);
-        
-        if (balances[sender] < amount) {
-            logger->warn("Insufficient qUSD balance for transfer from: " + sender);
+        // Verify price update is recent
+        auto current_price = oracle.get_current_price();
+        if (price.timestamp() + qOracleConfig::PRICE_UPDATE_TIMEOUT < current_price.timestamp) {
+            logger->warn("Price update too old for minting");
             return false;
         }
-        
-        balances[sender] -= amount;
-        balances[to] += amount;
-        
-        logger->info("qUSD transfer: " + std::to_string(amount) + " from " + sender + " to " + to);
         return true;
     }
 
-    uint64_t balanceOf(const std::string& addr) const {
-        std::lock_guard<std::mutex> lock(balance_mutex);
-        auto it = balances.find(addr);
-        return it != balances.end() ? it->second : 0;
+    // Every qBTC mint needs a committee attestation checked by
+    // mint_allowed(); a block transaction carries none, so blocks never mint
+    bool admits(const qOracle::BlockTx& tx) const {
+        return tx.kind != qOracle::TxKind::Mint && Ledger::admits(tx);
     }
 
-    uint64_t totalSupply() const { return total_supply.load(); }
-    std::string symbol() const { return "qUSD"; }
-    std::string name() const { return "Synthetic USDC"; }
-    uint64_t decimals() const { return qOracleConfig::QUSD_DECIMALS; }
+    qOracle::PriceMessage getCurrentPrice() const { return oracle.get_current_price(); }
+};
+
+// ========================== QUSD STABLECOIN ==========================
+class QUSDStablecoin : public Ledger<QusdPolicy> {
+public:
+    QUSDStablecoin(const std::string& deployer, const std::string& bridge_auth,
+                   std::shared_ptr<qOracle::AddressRegistry> reg, std::shared_ptr<ThreadSafeLogger> log,
+                   qOracle::LedgerMode mode = qOracleConfig::LEDGER_MODE) 
+        : Ledger(deployer, reg, log, mode) {
+        authority = bridge_auth;
+        authority_account = registry->intern(bridge_auth);
+    }
 };
 
 // ========================== CROSS-CHAIN BRIDGE ==========================
@@ -532,17 +931,87 @@ private:
     QOracleCommittee& oracle;
     QBTCSynthetic& qbtc;
     QUSDStablecoin& qusd;
-    std::unordered_map<std::string, uint64_t> bridge_balances;
-    std::atomic<uint64_t> daily_volume{0};
-    std::mutex bridge_mutex;
-    uint64_t last_volume_reset = 0;
+    std::shared_ptr<qOracle::AddressRegistry> registry;
+    qOracle::BalanceTable bridge_balances;      // STX deposited per account
+    mutable qOracle::VolumeLimiter volume_limiter{qOracleConfig::MAX_DAILY_VOLUME, qOracleConfig::VOLUME_WINDOW,
+                                                  qOracleConfig::VOLUME_BUCKET};
+    qOracle::AccountVolumeLimits account_limits{qOracleConfig::MAX_ACCOUNT_DAILY_VOLUME, qOracleConfig::VOLUME_WINDOW};
+    
+    qOracle::BlockLedger bridge_ledger() { return {&bridge_balances, nullptr}; }
+
+    static uint64_t now_seconds() {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    // Claim account and bridge volume up front; handed back if the swap does not commit
+    bool reserve_volume(qOracle::AccountId user, uint64_t amount, uint64_t now,
+                        qOracle::VolumeLimiter::Reservation& reservation) {
+        if (!account_limits.reserve(user, amount, now)) {
+            logger->warn("Account volume limit exceeded: " + registry->address(user));
+            return false;
+        }
+        reservation = volume_limiter.reserve(amount, now);
+        if (!reservation) {
+            account_limits.release(user, amount, now);
+            logger->warn("Daily volume limit exceeded");
+            return false;
+        }
+        return true;
+    }
+
+    qOracle::SwapNettingBook swap_book;
+    alignas(qOracle::CACHE_LINE_SIZE) std::atomic<bool> netting{false};    // Read by every swap
+    alignas(qOracle::CACHE_LINE_SIZE) qOracle::ProfiledMutex settle_mutex{"bridge.settle"};
+
+    // amount * price at the committee's 15-decimal price scale, rounded down
+    static bool quote(uint64_t amount, uint64_t price, uint64_t& out) {
+        return qOracle::quote<qOracleConfig::QUSD_DECIMALS>(amount, price, out, qOracle::Rounding::Down);
+    }
+
+    void release_volume(qOracle::AccountId user, uint64_t amount, uint64_t now,
+                        qOracle::VolumeLimiter::Reservation& reservation) {
+        volume_limiter.release(reservation);
+        account_limits.release(user, amount, now);
+    }
+    
+    // STX credit plus the net qBTC mint or burn of the chosen directions, as one transaction
+    bool commit_netted(qOracle::AccountId user, const qOracle::NettedSwap& swap, bool stx_leg, bool qbtc_leg,
+                       uint64_t minted, uint64_t stx_out) {
+        uint64_t stx_total = (stx_leg ? swap.stx_in : 0) + (qbtc_leg ? stx_out : 0);
+        uint64_t mint = stx_leg ? minted : 0, burn = qbtc_leg ? swap.qbtc_in : 0;
+        qOracle::LedgerTransaction txn;
+        txn.credit(bridge_ledger(), user, stx_total);
+        if (mint > burn) txn.mint(qbtc.block_ledger(), user, mint - burn);
+        else if (burn > mint) txn.burn(qbtc.block_ledger(), user, burn - mint);
+        return txn.commit();
+    }
+    
+    // Tell the account and indexers a queued direction was dropped, and
+    // hand back the volume it reserved, newest buckets first
+    void reject_netted(qOracle::AccountId user, const std::string& addr, qOracle::NettedSwap& swap,
+                       const char* asset, uint64_t amount, uint64_t volume, uint64_t now) {
+        logger->warn("Netted " + std::string(asset) + " swap of " + std::to_string(amount) + " rejected for " + addr);
+        emitEvent(qOracle::EventType::Swap, asset, addr, addr, amount, 0, qOracle::SWAP_REJECTED);
+        account_limits.release(user, volume, now);
+        for (auto it = swap.reservations.rbegin(); volume && it != swap.reservations.rend(); ++it) {
+            qOracle::VolumeLimiter::Reservation part = *it;
+            part.amount = std::min(volume, it->amount);
+            it->amount -= part.amount;
+            volume -= part.amount;
+            volume_limiter.release(part);
+        }
+    }
     
 public:
     CrossChainBridge(const std::string& deployer, QOracleCommittee& _oracle, 
-                     QBTCSynthetic& _qbtc, QUSDStablecoin& _qusd, std::shared_ptr<ThreadSafeLogger> log)
-        : LaunchProtect(deployer, log), oracle(_oracle), qbtc(_qbtc), qusd(_qusd) {}
+                     QBTCSynthetic& _qbtc, QUSDStablecoin& _qusd,
+                     std::shared_ptr<qOracle::AddressRegistry> reg, std::shared_ptr<ThreadSafeLogger> log)
+        : LaunchProtect(deployer, log), oracle(_oracle), qbtc(_qbtc), qusd(_qusd), registry(reg),
+          bridge_balances(qOracleConfig::LEDGER_MODE) {}
 
-    bool swap_stx_for_qbtc(const std::string& user, uint64_t stx_amount, const qOracle::PriceUpdate& price_update) {
+    // The STX deposit and the qBTC mint commit as one transaction
+    bool swap_stx_for_qbtc(const std::string& user, uint64_t stx_amount, const qOracle::VerifiedPrice& price) {
         requireActive(user);
         
         if (oracle.is_emergency_paused()) {
@@ -555,34 +1024,63 @@ public:
             return false;
         }
         
-        // Check daily volume limits
-        reset_daily_volume_if_needed();
-        if (daily_volume.load() + stx_amount > qOracleConfig::MAX_DAILY_VOLUME) {
-            logger->warn("Daily volume limit exceeded");
+        if (!oracle.issued(price)) {
+            logger->warn("Bridge swap rejected - price not attested by the committee");
             return false;
         }
         
-        // Calculate qBTC amount based on price
-        uint64_t qbtc_amount = (stx_amount * price_update.message.price) / qOracleConfig::QUSD_DECIMAL_MULTIPLIER;
+        // Queued swaps are checked before the user is registered
+        if (netting.load()) {
+            qbtc.authorize(user);
+            uint64_t now = now_seconds();
+            qOracle::AccountId user_id = registry->intern(user);
+            qOracle::VolumeLimiter::Reservation reservation;
+            if (!reserve_volume(user_id, stx_amount, now, reservation)) return false;
+            if (!swap_book.add_stx(user_id, stx_amount, now, reservation)) {
+                release_volume(user_id, stx_amount, now, reservation);
+                return false;
+            }
+            settle_if_due(now);
+            return true;
+        }
         
-        std::lock_guard<std::mutex> lock(bridge_mutex);
+        // Calculate qBTC amount based on price
+        uint64_t qbtc_amount;
+        if (!quote(stx_amount, price.price(), qbtc_amount)) {
+            logger->warn("Swap quote out of range: " + std::to_string(stx_amount) + " STX");
+            return false;
+        }
         
-        // Update bridge balances
-        bridge_balances[user] += stx_amount;
-        daily_volume.fetch_add(stx_amount);
+        qbtc.authorize(user);
+        if (!qbtc.mint_allowed(qbtc_amount, price)) {
+            logger->error("Failed to mint qBTC for bridge swap");
+            return false;
+        }
         
-        // Mint qBTC to user
-        if (!qbtc.mint(user, qbtc_amount, price_update)) {
+        // Check sliding-window volume limits
+        uint64_t now = now_seconds();
+        qOracle::AccountId user_id = registry->intern(user);
+        qOracle::VolumeLimiter::Reservation reservation;
+        if (!reserve_volume(user_id, stx_amount, now, reservation)) return false;
+        
+        qOracle::LedgerTransaction txn;
+        txn.credit(bridge_ledger(), user_id, stx_amount)
+           .mint(qbtc.block_ledger(), user_id, qbtc_amount);
+        if (!txn.commit()) {
+            release_volume(user_id, stx_amount, now, reservation);
             logger->error("Failed to mint qBTC for bridge swap");
             return false;
         }
+        qbtc.record_mint(user_id, qbtc_amount);
         
         logger->info("Bridge swap STX->qBTC: " + std::to_string(stx_amount) + " STX for " + 
                     std::to_string(qbtc_amount) + " qBTC by " + user);
+        emitEvent(qOracle::EventType::Swap, "STX", user, user, stx_amount, qbtc_amount);
         return true;
     }
 
-    bool swap_qbtc_for_stx(const std::string& user, uint64_t qbtc_amount, const qOracle::PriceUpdate& price_update) {
+    // The qBTC burn and the STX credit commit as one transaction
+    bool swap_qbtc_for_stx(const std::string& user, uint64_t qbtc_amount, const qOracle::VerifiedPrice& price) {
         requireActive(user);
         
         if (oracle.is_emergency_paused()) {
@@ -595,78 +1093,426 @@ public:
             return false;
         }
         
-        // Calculate STX amount based on price
-        uint64_t stx_amount = (qbtc_amount * price_update.message.price) / qOracleConfig::QUSD_DECIMAL_MULTIPLIER;
+        if (!oracle.issued(price)) {
+            logger->warn("Bridge swap rejected - price not attested by the committee");
+            return false;
+        }
         
-        // Check daily volume limits
-        reset_daily_volume_if_needed();
-        if (daily_volume.load() + stx_amount > qOracleConfig::MAX_DAILY_VOLUME) {
-            logger->warn("Daily volume limit exceeded");
+        if (netting.load()) {
+            qbtc.authorize(user);
+            uint64_t now = now_seconds();
+            qOracle::AccountId user_id = registry->find(user);
+            if (user_id == qOracle::INVALID_ACCOUNT) {
+                logger->warn("Swap exceeds available qBTC: " + user);
+                return false;
+            }
+            // Volume is charged in STX at the request's own price
+            uint64_t stx_quoted;
+            if (!quote(qbtc_amount, price.price(), stx_quoted) || stx_quoted == 0) {
+                logger->warn("Swap quote out of range: " + std::to_string(qbtc_amount) + " qBTC");
+                return false;
+            }
+            qOracle::VolumeLimiter::Reservation reservation;
+            if (!reserve_volume(user_id, stx_quoted, now, reservation)) return false;
+            if (!swap_book.add_qbtc(user_id, qbtc_amount, qbtc.balanceOf(user_id), now, reservation)) {
+                release_volume(user_id, stx_quoted, now, reservation);
+                logger->warn("Swap exceeds available qBTC: " + user);
+                return false;
+            }
+            settle_if_due(now);
+            return true;
+        }
+        
+        // Burns are held to the same price age as the mints they unwind
+        if (price.timestamp() + qOracleConfig::PRICE_UPDATE_TIMEOUT < oracle.get_current_price().timestamp) {
+            logger->warn("Price update too old for swap");
             return false;
         }
         
-        std::lock_guard<std::mutex> lock(bridge_mutex);
+        // Calculate STX amount based on price
+        uint64_t stx_amount;
+        if (!quote(qbtc_amount, price.price(), stx_amount)) {
+            logger->warn("Swap quote out of range: " + std::to_string(qbtc_amount) + " qBTC");
+            return false;
+        }
         
-        // Burn qBTC from user
-        if (!qbtc.burn(user, qbtc_amount)) {
+        qbtc.authorize(user);
+        qOracle::AccountId user_id = registry->find(user);
+        if (user_id == qOracle::INVALID_ACCOUNT || stx_amount == 0) {
             logger->error("Failed to burn qBTC for bridge swap");
             return false;
         }
         
-        // Update bridge balances
-        bridge_balances[user] += stx_amount;
-        daily_volume.fetch_add(stx_amount);
+        // Check sliding-window volume limits
+        uint64_t now = now_seconds();
+        qOracle::VolumeLimiter::Reservation reservation;
+        if (!reserve_volume(user_id, stx_amount, now, reservation)) return false;
+        
+        qOracle::LedgerTransaction txn;
+        txn.burn(qbtc.block_ledger(), user_id, qbtc_amount)
+           .credit(bridge_ledger(), user_id, stx_amount);
+        if (!txn.commit()) {
+            release_volume(user_id, stx_amount, now, reservation);
+            logger->error("Failed to burn qBTC for bridge swap");
+            return false;
+        }
+        qbtc.record_burn(user_id, qbtc_amount);
         
         logger->info("Bridge swap qBTC->STX: " + std::to_string(qbtc_amount) + " qBTC for " + 
                     std::to_string(stx_amount) + " STX by " + user);
+        emitEvent(qOracle::EventType::Swap, "qBTC", user, user, qbtc_amount, stx_amount);
         return true;
     }
 
     uint64_t getBridgeBalance(const std::string& user) const {
-        std::lock_guard<std::mutex> lock(bridge_mutex);
-        auto it = bridge_balances.find(user);
-        return it != bridge_balances.end() ? it->second : 0;
+        return bridge_balances.get(registry->find(user));
     }
     
-    uint64_t getDailyVolume() const { return daily_volume.load(); }
+    // In netting mode swaps are queued rather than applied: the swap calls
+    // return true once the request is accepted into the open epoch. Their
+    // price must still be attested but is not used; settle_swaps() later
+    // applies each account's epoch at the committee's current price.
+    // Turning netting off settles whatever is still queued.
+    void set_netting(const std::string& sender, bool enabled) {
+        requireGovernance(sender);
+        netting.store(enabled);
+        logger->info(std::string("Swap netting ") + (enabled ? "enabled" : "disabled") + " by: " + sender);
+        if (!enabled) settle_swaps();
+    }
     
-    void reset_daily_volume_if_needed() {
-        uint64_t now = std::chrono::duration_cast<std::chrono::seconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count();
+    bool is_netting() const { return netting.load(); }
+    
+    struct SettlementReport {
+        uint64_t epoch = 0;
+        uint64_t price = 0;
+        size_t accounts = 0;            // Accounts settled
+        size_t rejected = 0;            // Accounts with a direction dropped (Swap events with SWAP_REJECTED)
+        size_t swaps = 0;               // Requests settled
+        uint64_t stx_credited = 0;
+        uint64_t qbtc_minted = 0;
+        uint64_t qbtc_burned = 0;
+    };
+    
+    // Settle the open epoch once it is SWAP_NETTING_EPOCH seconds old
+    void settle_if_due(uint64_t now) {
+        if (swap_book.due(now, qOracleConfig::SWAP_NETTING_EPOCH)) settle_swaps();
+    }
+    
+    // Apply every queued swap at one verified price: each account gets its
+    // STX credit plus a single net qBTC mint or burn in one transaction.
+    // A direction that cannot settle is dropped with a SWAP_REJECTED event
+    // and its queued volume handed back. Nothing is drained while the
+    // committee is paused or has no price.
+    SettlementReport settle_swaps() {
+        std::lock_guard<qOracle::ProfiledMutex> serial(settle_mutex);
+        SettlementReport report;
+        qOracle::VerifiedPrice price = oracle.verified_price();
+        if (oracle.is_emergency_paused() || !price || price.price() == 0) {
+            if (swap_book.pending_requests()) logger->warn("Swap settlement deferred - no usable committee price");
+            return report;
+        }
+        report.price = price.price();
+        
+        uint64_t now = now_seconds();
+        auto entries = swap_book.take(report.epoch);
+        for (auto& entry : entries) {
+            qOracle::AccountId user_id = entry.first;
+            qOracle::NettedSwap& swap = entry.second;
+            if (swap.stx_swaps + swap.qbtc_swaps == 0) continue;
+            
+            // Each direction settles unless its own quote fails, and a net
+            // burn the account can no longer cover drops only its returns
+            uint64_t minted = 0, stx_out = 0;
+            bool stx_leg = swap.stx_swaps && quote(swap.stx_in, price.price(), minted);
+            bool qbtc_leg = swap.qbtc_swaps && quote(swap.qbtc_in, price.price(), stx_out) && stx_out != 0 &&
+                            stx_out <= std::numeric_limits<uint64_t>::max() - swap.stx_in;
+            bool committed = (stx_leg || qbtc_leg) && commit_netted(user_id, swap, stx_leg, qbtc_leg, minted, stx_out);
+            if (!committed && stx_leg && qbtc_leg) {
+                qbtc_leg = false;
+                committed = commit_netted(user_id, swap, stx_leg, qbtc_leg, minted, stx_out);
+            }
+            if (!committed) stx_leg = qbtc_leg = false;
+            
+            std::string addr = registry->address(user_id);
+            if (swap.stx_swaps && !stx_leg) reject_netted(user_id, addr, swap, "STX", swap.stx_in, swap.stx_volume, now);
+            if (swap.qbtc_swaps && !qbtc_leg) reject_netted(user_id, addr, swap, "qBTC", swap.qbtc_in, swap.qbtc_volume, now);
+            if ((swap.stx_swaps && !stx_leg) || (swap.qbtc_swaps && !qbtc_leg)) report.rejected++;
+            if (!committed) continue;
+            
+            uint64_t qbtc_in = qbtc_leg ? swap.qbtc_in : 0;
+            if (!stx_leg) minted = 0;
+            if (!qbtc_leg) stx_out = 0;
+            if (minted > qbtc_in) {
+                qbtc.record_mint(user_id, minted - qbtc_in);
+                report.qbtc_minted += minted - qbtc_in;
+            } else if (qbtc_in > minted) {
+                qbtc.record_burn(user_id, qbtc_in - minted);
+                report.qbtc_burned += qbtc_in - minted;
+            }
+            if (stx_leg) emitEvent(qOracle::EventType::Swap, "STX", addr, addr, swap.stx_in, minted);
+            if (qbtc_leg) emitEvent(qOracle::EventType::Swap, "qBTC", addr, addr, swap.qbtc_in, stx_out);
+            report.accounts++;
+            report.swaps += (stx_leg ? swap.stx_swaps : 0) + (qbtc_leg ? swap.qbtc_swaps : 0);
+            report.stx_credited += (stx_leg ? swap.stx_in : 0) + stx_out;
+        }
         
-        if (now - last_volume_reset >= 86400) { // 24 hours
-            daily_volume.store(0);
-            last_volume_reset = now;
+        if (report.accounts || report.rejected) {
+            logger->info("Swap epoch " + std::to_string(report.epoch) + " settled at " + std::to_string(report.price) +
+                        ": " + std::to_string(report.swaps) + " swaps over " + std::to_string(report.accounts) +
+                        " accounts, " + std::to_string(report.rejected) + " rejected, qBTC +" +
+                        std::to_string(report.qbtc_minted) + "/-" + std::to_string(report.qbtc_burned));
         }
+        return report;
     }
+    
+    // Quote many amounts at one committee price; false if any entry
+    // overflowed (those entries are 0)
+    bool quote_batch(const std::vector<uint64_t>& amounts, uint64_t price, std::vector<uint64_t>& out) const {
+        out.resize(amounts.size());
+        return qOracle::quote_batch<qOracleConfig::QUSD_DECIMALS>(amounts.data(), out.data(), amounts.size(), price);
+    }
+    
+    bool set_daily_volume_limit(const std::string& sender, uint64_t limit) {
+        requireGovernance(sender);
+        if (!volume_limiter.set_limit(limit)) return false;
+        logger->info("Daily volume limit set to " + std::to_string(limit) + " by: " + sender);
+        return true;
+    }
+    
+    bool set_account_volume_limit(const std::string& sender, uint64_t limit) {
+        requireGovernance(sender);
+        account_limits.set_limit(limit);
+        logger->info("Account volume limit set to " + std::to_string(limit) + " by: " + sender);
+        return true;
+    }
+    
+    // Volume in the sliding window ending now
+    uint64_t getDailyVolume() const { return volume_limiter.used(now_seconds()); }
+    
+    // Drop per-account windows with nothing left in them
+    size_t prune_volume_limits() { return account_limits.prune(now_seconds()); }
 };
 
 // ========================== GOVERNANCE MULTISIG ==========================
+enum class ProposalState : uint8_t {
+    Pending,    // Inside its execution delay
+    Ready,      // Executable once it holds threshold signatures
+    Executed,
+    Expired     // Not executed within PROPOSAL_DURATION
+};
+
 struct Proposal {
     std::string to;
     uint64_t value;
     std::string data;
     uint64_t nonce;
-    bool executed;
-    std::set<std::string> signatures;
-    std::string action;
-    std::string parameter;
+    uint64_t signers;                   // Bit i set once owners[i] has signed
+    qOracle::GovernanceCommand command; // Compiled from the action and parameter at proposal time
     uint64_t created_time;
     uint64_t execution_delay;
+    uint64_t expiry_time;
+    ProposalState state = ProposalState::Pending;
+    qOracle::TimingWheel::Handle timer = qOracle::TimingWheel::NO_TIMER;
+    
+    size_t signature_count() const { return static_cast<size_t>(__builtin_popcountll(signers)); }
+};
+
+// What remains of a proposal once it is executed or expired; the event
+// log keeps the full history
+struct ProposalRecord {
+    uint64_t value;
+    uint64_t created_time;
+    uint64_t closed_time;
+    uint64_t signers;
+    qOracle::GovernanceCommand command;
+    ProposalState state;
+};
+
+// Per-item outcome of a governance call
+enum class ProposalStatus : uint8_t {
+    Ok,
+    NotOwner,
+    NotFound,
+    AlreadySigned,
+    AlreadyExecuted,
+    Expired,
+    DelayNotMet,
+    InsufficientSignatures,
+    InvalidAction,
+    ActionFailed
+};
+
+// One proposal for propose_batch()
+struct ProposalSpec {
+    std::string to;
+    uint64_t value;
+    std::string data;
+    std::string action;
+    std::string parameter;
 };
 
 class QnosisMultisig : public LaunchProtect {
+public:
+    static constexpr size_t MAX_OWNERS = 64;    // One bit per owner in Proposal::signers
+    using Clock = uint64_t (*)();               // Seconds since the epoch
+    
+    static uint64_t wall_clock() {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    
 private:
     std::vector<std::string> owners;
+    qOracle::FlatHashMap<std::string, uint32_t> owner_bits;    // Owner address -> index in owners
     uint32_t threshold;
     std::atomic<uint64_t> proposal_nonce{1};
-    std::unordered_map<uint64_t, Proposal> proposals;
-    std::mutex proposal_mutex;
+    qOracle::NonceTable<Proposal, ProposalRecord> proposals{1};
+    const Clock clock;
+    qOracle::TimingWheel deadlines;             // One-second ticks; each live proposal holds one timer
+    std::vector<uint64_t> ready_queue;          // Ready with threshold signatures, in the order they qualified
+    bool auto_execute;
+    qOracle::ActionTable actions;
+    mutable qOracle::ProfiledMutex proposal_mutex{"governance.proposals"};
+    
+    // Bit for an owner, 0 for anyone else
+    uint64_t owner_bit(const std::string& address) const {
+        auto it = owner_bits.find(address);
+        return it != owner_bits.end() ? uint64_t(1) << it->second : 0;
+    }
+    
+    // Swap a closed proposal for its compact record
+    void archive_locked(Proposal& prop, uint64_t closed_time) {
+        proposals.archive(prop.nonce, ProposalRecord{prop.value, prop.created_time, closed_time,
+                                                     prop.signers, prop.command, prop.state});
+    }
+    
+    uint64_t current_time() const { return clock(); }
+    
+    // Fire every delay and expiry deadline up to now
+    size_t advance_locked(uint64_t now) {
+        return deadlines.advance(now, [this](uint64_t nonce, uint64_t deadline) {
+            Proposal* prop = proposals.find(nonce);
+            if (!prop) return;
+            prop->timer = qOracle::TimingWheel::NO_TIMER;
+            if (prop->state == ProposalState::Pending) {
+                prop->state = ProposalState::Ready;
+                prop->timer = deadlines.schedule(prop->expiry_time, nonce);
+                if (prop->signature_count() >= threshold) ready_queue.push_back(nonce);
+            } else if (prop->state == ProposalState::Ready) {
+                prop->state = ProposalState::Expired;
+                logger->info("Proposal expired: " + std::to_string(nonce));
+                emitEvent(qOracle::EventType::Proposal, "", "", prop->to, prop->value, nonce,
+                          static_cast<uint8_t>(qOracle::ProposalAction::Expired));
+                unqueue_locked(nonce);
+                archive_locked(*prop, deadline);
+            }
+        });
+    }
+    
+    // Why a nonce has no live proposal
+    ProposalStatus closed_status(uint64_t nonce) const {
+        const ProposalRecord* record = proposals.archived(nonce);
+        if (!record) return ProposalStatus::NotFound;
+        return record->state == ProposalState::Executed ? ProposalStatus::AlreadyExecuted : ProposalStatus::Expired;
+    }
+    
+    static std::string status_message(ProposalStatus status) {
+        switch (status) {
+            case ProposalStatus::Ok: return "ok";
+            case ProposalStatus::NotOwner: return "not an owner";
+            case ProposalStatus::NotFound: return "proposal not found";
+            case ProposalStatus::AlreadySigned: return "already signed";
+            case ProposalStatus::AlreadyExecuted: return "proposal already executed";
+            case ProposalStatus::Expired: return "proposal expired";
+            case ProposalStatus::DelayNotMet: return "execution delay not met";
+            case ProposalStatus::InsufficientSignatures: return "insufficient signatures";
+            case ProposalStatus::InvalidAction: return "invalid action or parameter";
+            case ProposalStatus::ActionFailed: return "action failed";
+        }
+        return "unknown";
+    }
+    
+    // Returns 0 if the action does not compile
+    uint64_t propose_locked(const std::string& proposer, const ProposalSpec& spec, uint64_t now) {
+        qOracle::GovernanceCommand command;
+        if (!qOracle::compile(spec.action, spec.parameter, command)) return 0;
+        uint64_t nonce = proposal_nonce.fetch_add(1);
+        Proposal prop{spec.to, spec.value, spec.data, nonce, 0, command, now,
+                      qOracleConfig::GOVERNANCE_EXECUTION_DELAY, now + qOracleConfig::PROPOSAL_DURATION};
+        prop.timer = deadlines.schedule(now + prop.execution_delay, nonce);
+        proposals.append(nonce, std::move(prop));
+        emitEvent(qOracle::EventType::Proposal, "", proposer, spec.to, spec.value, nonce,
+                  static_cast<uint8_t>(qOracle::ProposalAction::Created));
+        return nonce;
+    }
+    
+    ProposalStatus sign_locked(uint64_t nonce, uint64_t bit, const std::string& signer) {
+        Proposal* prop = proposals.find(nonce);
+        if (!prop) return closed_status(nonce);
+        if (prop->signers & bit) return ProposalStatus::AlreadySigned;
+        prop->signers |= bit;
+        if (prop->state == ProposalState::Ready && prop->signature_count() == threshold) {
+            ready_queue.push_back(nonce);
+        }
+        emitEvent(qOracle::EventType::Proposal, "", signer, "", prop->signature_count(), nonce,
+                  static_cast<uint8_t>(qOracle::ProposalAction::Signed));
+        return ProposalStatus::Ok;
+    }
+    
+    // Drop a proposal that closed outside drain_ready_locked(); the queue
+    // only holds ready proposals, so the scan stays short
+    void unqueue_locked(uint64_t nonce) {
+        auto it = std::find(ready_queue.begin(), ready_queue.end(), nonce);
+        if (it != ready_queue.end()) ready_queue.erase(it);
+    }
+    
+    // Run the proposal's action; on failure the proposal stays ready
+    bool execute_locked(Proposal& prop, uint64_t now) {
+        bool applied;
+        try {
+            applied = actions.dispatch(prop.command);
+        } catch (const std::exception& e) {
+            logger->error("Proposal " + std::to_string(prop.nonce) + " action threw: " + e.what());
+            applied = false;
+        }
+        if (!applied) return false;
+        
+        deadlines.cancel(prop.timer);
+        prop.timer = qOracle::TimingWheel::NO_TIMER;
+        prop.state = ProposalState::Executed;
+        emitEvent(qOracle::EventType::Proposal, "", "", prop.to, prop.value, prop.nonce,
+                  static_cast<uint8_t>(qOracle::ProposalAction::Executed));
+        archive_locked(prop, now);
+        return true;
+    }
+    
+    // Execute every queued proposal that is still ready; returns their
+    // nonces. Proposals whose action failed stay queued for a retry.
+    std::vector<uint64_t> drain_ready_locked(uint64_t now) {
+        std::vector<uint64_t> executed;
+        std::vector<uint64_t> retry;
+        for (uint64_t nonce : ready_queue) {
+            Proposal* prop = proposals.find(nonce);
+            if (!prop || prop->state != ProposalState::Ready || prop->signature_count() < threshold) continue;
+            if (execute_locked(*prop, now)) executed.push_back(nonce);
+            else retry.push_back(nonce);
+        }
+        ready_queue.swap(retry);
+        return executed;
+    }
     
 public:
     QnosisMultisig(const std::string& deployer, const std::vector<std::string>& initial_owners, 
-                   uint32_t thresh, std::shared_ptr<ThreadSafeLogger> log)
-        : LaunchProtect(deployer, log), owners(initial_owners), threshold(thresh) {
+                   uint32_t thresh, std::shared_ptr<ThreadSafeLogger> log,
+                   bool auto_exec = qOracleConfig::GOVERNANCE_AUTO_EXECUTE, Clock clock_source = wall_clock)
+        : LaunchProtect(deployer, log), owners(initial_owners), threshold(thresh),
+          clock(clock_source), deadlines(clock_source()), auto_execute(auto_exec) {
+        if (owners.size() > MAX_OWNERS) throw std::invalid_argument("Multisig supports at most 64 owners");
+        for (size_t i = 0; i < owners.size(); ++i) {
+            if (!owner_bits.emplace(owners[i], static_cast<uint32_t>(i)).second) {
+                throw std::invalid_argument("Duplicate multisig owner: " + owners[i]);
+            }
+        }
         logger->info("Governance multisig initialized with " + std::to_string(owners.size()) + 
                     " owners, threshold: " + std::to_string(threshold));
     }
@@ -675,95 +1521,213 @@ public:
                     const std::string& data, const std::string& action, const std::string& parameter) {
         requireActive(proposer);
         
-        if (std::find(owners.begin(), owners.end(), proposer) == owners.end()) {
+        if (!owner_bit(proposer)) {
             logger->warn("Proposal rejected - not an owner: " + proposer);
             return 0;
         }
         
-        std::lock_guard<std::mutex> lock(proposal_mutex);
-        
-        uint64_t nonce = proposal_nonce.fetch_add(1);
-        uint64_t now = std::chrono::duration_cast<std::chrono::seconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count();
-        
-        Proposal prop{to, value, data, nonce, false, {}, action, parameter, now, 86400}; // 24h delay
-        proposals[nonce] = prop;
+        std::lock_guard<qOracle::ProfiledMutex> lock(proposal_mutex);
+        uint64_t nonce = propose_locked(proposer, ProposalSpec{to, value, data, action, parameter}, current_time());
+        if (nonce == 0) {
+            logger->warn("Proposal rejected - invalid action: " + action + "(" + parameter + ")");
+            return 0;
+        }
         
         logger->info("Proposal created: " + std::to_string(nonce) + " by " + proposer + 
                     " action: " + action);
         return nonce;
     }
 
+    // Create several proposals under one lock; nonces in input order
+    std::vector<uint64_t> propose_batch(const std::string& proposer, const std::vector<ProposalSpec>& specs) {
+        requireActive(proposer);
+        
+        if (!owner_bit(proposer)) {
+            logger->warn("Proposal batch rejected - not an owner: " + proposer);
+            return std::vector<uint64_t>(specs.size(), 0);
+        }
+        
+        std::vector<uint64_t> nonces;
+        nonces.reserve(specs.size());
+        std::lock_guard<qOracle::ProfiledMutex> lock(proposal_mutex);
+        uint64_t now = current_time();
+        size_t created = 0;
+        for (const auto& spec : specs) {
+            nonces.push_back(propose_locked(proposer, spec, now));
+            if (nonces.back()) ++created;
+        }
+        
+        logger->info("Proposals created by " + proposer + ": " + std::to_string(created) + "/" +
+                    std::to_string(specs.size()));
+        return nonces;
+    }
+
     void sign(uint64_t nonce, const std::string& signer) {
         requireActive(signer);
         
-        if (std::find(owners.begin(), owners.end(), signer) == owners.end()) {
+        uint64_t bit = owner_bit(signer);
+        if (!bit) {
             logger->warn("Signature rejected - not an owner: " + signer);
             return;
         }
         
-        std::lock_guard<std::mutex> lock(proposal_mutex);
+        std::lock_guard<qOracle::ProfiledMutex> lock(proposal_mutex);
+        advance_locked(current_time());
         
-        auto it = proposals.find(nonce);
-        if (it == proposals.end()) {
-            logger->warn("Proposal not found for signing: " + std::to_string(nonce));
+        ProposalStatus status = sign_locked(nonce, bit, signer);
+        if (status == ProposalStatus::AlreadySigned) return;
+        if (status != ProposalStatus::Ok) {
+            logger->warn("Signature rejected for proposal " + std::to_string(nonce) + ": " + status_message(status));
             return;
         }
         
-        if (it->second.executed) {
-            logger->warn("Proposal already executed: " + std::to_string(nonce));
-            return;
-        }
-        
-        it->second.signatures.insert(signer);
-        
         logger->info("Proposal signed: " + std::to_string(nonce) + " by " + signer + 
-                    " signatures: " + std::to_string(it->second.signatures.size()) + "/" + 
+                    " signatures: " + std::to_string(proposals.find(nonce)->signature_count()) + "/" + 
                     std::to_string(threshold));
     }
 
-    void execute(uint64_t nonce) {
-        std::lock_guard<std::mutex> lock(proposal_mutex);
+    // Sign several proposals under one lock; statuses in input order
+    std::vector<ProposalStatus> sign_batch(const std::string& signer, const std::vector<uint64_t>& nonces) {
+        requireActive(signer);
         
-        auto it = proposals.find(nonce);
-        if (it == proposals.end()) {
-            logger->warn("Proposal not found for execution: " + std::to_string(nonce));
-            return;
+        uint64_t bit = owner_bit(signer);
+        if (!bit) {
+            logger->warn("Signature batch rejected - not an owner: " + signer);
+            return std::vector<ProposalStatus>(nonces.size(), ProposalStatus::NotOwner);
         }
         
-        if (it->second.executed) {
-            logger->warn("Proposal already executed: " + std::to_string(nonce));
-            return;
+        std::vector<ProposalStatus> status;
+        status.reserve(nonces.size());
+        size_t signed_count = 0;
+        {
+            std::lock_guard<qOracle::ProfiledMutex> lock(proposal_mutex);
+            advance_locked(current_time());
+            for (uint64_t nonce : nonces) {
+                status.push_back(sign_locked(nonce, bit, signer));
+                if (status.back() == ProposalStatus::Ok) ++signed_count;
+            }
         }
         
-        if (it->second.signatures.size() < threshold) {
-            logger->warn("Insufficient signatures for execution: " + std::to_string(nonce));
+        logger->info("Proposals signed by " + signer + ": " + std::to_string(signed_count) + "/" +
+                    std::to_string(nonces.size()));
+        return status;
+    }
+
+    void execute(uint64_t nonce) {
+        std::lock_guard<qOracle::ProfiledMutex> lock(proposal_mutex);
+        uint64_t now = current_time();
+        advance_locked(now);
+        
+        Proposal* prop = proposals.find(nonce);
+        ProposalStatus status = !prop ? closed_status(nonce)
+                              : prop->state == ProposalState::Pending ? ProposalStatus::DelayNotMet
+                              : prop->signature_count() < threshold ? ProposalStatus::InsufficientSignatures
+                              : ProposalStatus::Ok;
+        if (status != ProposalStatus::Ok) {
+            logger->warn("Proposal " + std::to_string(nonce) + " not executed: " + status_message(status));
             return;
         }
         
-        uint64_t now = std::chrono::duration_cast<std::chrono::seconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count();
-        
-        if (now < it->second.created_time + it->second.execution_delay) {
-            logger->warn("Execution delay not met for proposal: " + std::to_string(nonce));
+        qOracle::GovernanceAction action = prop->command.action;
+        if (!execute_locked(*prop, now)) {
+            logger->warn("Proposal " + std::to_string(nonce) + " not executed: " +
+                        status_message(ProposalStatus::ActionFailed));
             return;
         }
-        
-        it->second.executed = true;
-        
-        logger->info("Proposal executed: " + std::to_string(nonce) + " action: " + it->second.action);
+        unqueue_locked(nonce);
+        logger->info("Proposal executed: " + std::to_string(nonce) + " action: " + qOracle::action_name(action));
+    }
+
+    // Execute every proposal that is past its delay and holds threshold
+    // signatures, under one lock; returns their nonces in queue order
+    std::vector<uint64_t> execute_ready() {
+        std::lock_guard<qOracle::ProfiledMutex> lock(proposal_mutex);
+        uint64_t now = current_time();
+        advance_locked(now);
+        std::vector<uint64_t> executed = drain_ready_locked(now);
+        if (!executed.empty()) logger->info("Proposals executed: " + std::to_string(executed.size()));
+        return executed;
+    }
+
+    // Move proposals through their delay and expiry deadlines; with
+    // auto-execution on, also execute every proposal that became ready.
+    // Returns the number of state changes.
+    size_t tick() {
+        std::lock_guard<qOracle::ProfiledMutex> lock(proposal_mutex);
+        uint64_t now = current_time();
+        size_t changes = advance_locked(now);
+        if (!auto_execute) return changes;
+        
+        size_t executed = drain_ready_locked(now).size();
+        if (executed) logger->info("Proposals auto-executed: " + std::to_string(executed));
+        return changes + executed;
+    }
+
+    // Proposals that execute() would accept right now, oldest first
+    std::vector<uint64_t> ready_proposals() {
+        std::lock_guard<qOracle::ProfiledMutex> lock(proposal_mutex);
+        advance_locked(current_time());
+        
+        // execute() and expiry unqueue their proposals; filter anyway so a
+        // closed proposal is never reported
+        ready_queue.erase(std::remove_if(ready_queue.begin(), ready_queue.end(), [this](uint64_t nonce) {
+            const Proposal* prop = proposals.find(nonce);
+            return !prop || prop->state != ProposalState::Ready;
+        }), ready_queue.end());
+        return ready_queue;
+    }
+
+    // Attach the handler that carries out an action when a proposal executes
+    void bindAction(const std::string& sender, qOracle::GovernanceAction action, qOracle::ActionTable::Handler handler) {
+        requireAdmin(sender);
+        std::lock_guard<qOracle::ProfiledMutex> lock(proposal_mutex);
+        actions.bind(action, std::move(handler));
     }
 
     std::vector<std::string> getOwners() const { return owners; }
     uint32_t getThreshold() const { return threshold; }
     bool isExecuted(uint64_t nonce) const { 
-        std::lock_guard<std::mutex> lock(proposal_mutex);
-        auto it = proposals.find(nonce);
-        return it != proposals.end() ? it->second.executed : false;
+        return getState(nonce) == ProposalState::Executed;
+    }
+    
+    // State as of the last tick, sign or execute; unknown nonces report Expired
+    ProposalState getState(uint64_t nonce) const {
+        std::lock_guard<qOracle::ProfiledMutex> lock(proposal_mutex);
+        if (const Proposal* prop = proposals.find(nonce)) return prop->state;
+        const ProposalRecord* record = proposals.archived(nonce);
+        return record ? record->state : ProposalState::Expired;
+    }
+    
+    struct GovernanceStats {
+        size_t live_proposals = 0;
+        size_t archived_proposals = 0;
+        size_t table_bytes = 0;
+    };
+    
+    GovernanceStats governance_stats() const {
+        std::lock_guard<qOracle::ProfiledMutex> lock(proposal_mutex);
+        return GovernanceStats{proposals.live_size(), proposals.archived_size(), proposals.memory_bytes()};
+    }
+    
+    size_t scheduled_deadlines() const {
+        std::lock_guard<qOracle::ProfiledMutex> lock(proposal_mutex);
+        return deadlines.size();
     }
 };
 
 // ========================== MAIN QORACLE SYSTEM ==========================
+struct LedgerMetrics {
+    qOracle::LedgerStats bkpy;
+    qOracle::LedgerStats qbtc;
+    qOracle::LedgerStats qusd;
+    size_t registered_accounts = 0;
+    size_t registry_bytes = 0;
+    size_t snapshot_nodes = 0;         // Trie nodes held by retained epochs, all ledgers
+    size_t snapshot_bytes = 0;
+    size_t total_ledger_bytes = 0;     // Balance chunks, snapshots and the address registry
+    size_t bytes_per_account = 0;      // total_ledger_bytes per registered account
+};
+
 class QOracleSystem {
 private:
     std::unique_ptr<QOracleCommittee> oracle_committee;
@@ -773,26 +1737,86 @@ private:
     std::unique_ptr<CrossChainBridge> bridge;
     std::unique_ptr<QnosisMultisig> governance;
     std::shared_ptr<ThreadSafeLogger> logger;
+    std::shared_ptr<qOracle::EventStore> event_store;
+    std::shared_ptr<qOracle::AddressRegistry> address_registry;
+    std::unique_ptr<qOracle::BlockExecutor> block_executor;
+    std::unique_ptr<qOracle::LedgerCompactor> ledger_compactor;
+    qOracle::ProfiledMutex commit_mutex{"system.commit"};
     
 public:
     QOracleSystem(const std::string& deployer, 
                   const std::array<qOracle::Dilithium3PubKey, qOracleConfig::NUM_ORACLES>& oracle_keys,
                   const std::array<std::string, qOracleConfig::NUM_ORACLES>& oracle_addresses,
                   const std::vector<std::string>& governance_owners,
-                  const std::string& bridge_authority) {
+                  const std::string& bridge_authority,
+                  QnosisMultisig::Clock governance_clock = QnosisMultisig::wall_clock) {
         
         logger = std::make_shared<ThreadSafeLogger>("qoracle_production.log");
+        address_registry = std::make_shared<qOracle::AddressRegistry>();
+        block_executor = std::make_unique<qOracle::BlockExecutor>(
+            std::max(1u, std::thread::hardware_concurrency()), qOracleConfig::BLOCK_PARALLEL_WAVES);
         
         oracle_committee = std::make_unique<QOracleCommittee>(deployer, oracle_keys, oracle_addresses, logger);
-        bkpy_token = std::make_unique<BankonPythaiToken>(deployer, logger);
-        qbtc_token = std::make_unique<QBTCSynthetic>(deployer, *oracle_committee, logger);
-        qusd_token = std::make_unique<QUSDStablecoin>(deployer, bridge_authority, logger);
-        bridge = std::make_unique<CrossChainBridge>(deployer, *oracle_committee, *qbtc_token, *qusd_token, logger);
-        governance = std::make_unique<QnosisMultisig>(deployer, governance_owners, 3, logger); // 3-of-N threshold
+        bkpy_token = std::make_unique<BankonPythaiToken>(deployer, address_registry, logger);
+        qbtc_token = std::make_unique<QBTCSynthetic>(deployer, *oracle_committee, address_registry, logger);
+        qusd_token = std::make_unique<QUSDStablecoin>(deployer, bridge_authority, address_registry, logger);
+        bridge = std::make_unique<CrossChainBridge>(deployer, *oracle_committee, *qbtc_token, *qusd_token, address_registry, logger);
+        governance = std::make_unique<QnosisMultisig>(deployer, governance_owners, 3, logger, // 3-of-N threshold
+                                                      qOracleConfig::GOVERNANCE_AUTO_EXECUTE, governance_clock);
+        bind_governance(deployer);
+        
+        // Indexed event log for explorers/indexers
+        event_store = std::make_shared<qOracle::EventStore>("qoracle_events");
+        oracle_committee->attachEventStore(event_store);
+        bkpy_token->attachEventStore(event_store);
+        qbtc_token->attachEventStore(event_store);
+        qusd_token->attachEventStore(event_store);
+        bridge->attachEventStore(event_store);
+        governance->attachEventStore(event_store);
+        
+        // Return chunks of drained accounts to the allocator in the background
+        ledger_compactor = std::make_unique<qOracle::LedgerCompactor>(
+            std::vector<qOracle::BalanceTable*>{
+                bkpy_token->block_ledger().balances, qbtc_token->block_ledger().balances,
+                qusd_token->block_ledger().balances
+            },
+            std::chrono::seconds(qOracleConfig::LEDGER_COMPACTION_INTERVAL),
+            [log = logger, bridge = bridge.get()](const qOracle::LedgerStats& stats) {
+                bridge->prune_volume_limits();
+                if (stats.released_chunks == 0) return;
+                log->info("Ledger compaction released " + std::to_string(stats.released_chunks) +
+                         " chunks, " + std::to_string(stats.ledger_bytes) + " bytes live");
+            });
+        ledger_compactor->start();
         
         logger->info("QOracle System initialized successfully");
     }
 
+    // Executed proposals act on the committee and bridge as GOVERNANCE_ACCOUNT
+    void bind_governance(const std::string& deployer) {
+        using qOracle::GovernanceAction;
+        const std::string gov = qOracleConfig::GOVERNANCE_ACCOUNT;
+        oracle_committee->setGovernance(deployer, gov);
+        bridge->setGovernance(deployer, gov);
+        
+        QOracleCommittee* committee = oracle_committee.get();
+        CrossChainBridge* bridge_ptr = bridge.get();
+        governance->bindAction(deployer, GovernanceAction::PauseOracle,
+            [committee, gov](uint64_t) { return committee->set_emergency_pause(gov, true); });
+        governance->bindAction(deployer, GovernanceAction::ResumeOracle,
+            [committee, gov](uint64_t) { return committee->set_emergency_pause(gov, false); });
+        governance->bindAction(deployer, GovernanceAction::DeactivateOracle,
+            [committee, gov](uint64_t index) { return committee->set_oracle_active(gov, index, false); });
+        governance->bindAction(deployer, GovernanceAction::ActivateOracle,
+            [committee, gov](uint64_t index) { return committee->set_oracle_active(gov, index, true); });
+        governance->bindAction(deployer, GovernanceAction::SetSwapNetting,
+            [bridge_ptr, gov](uint64_t enabled) { bridge_ptr->set_netting(gov, enabled != 0); return true; });
+        governance->bindAction(deployer, GovernanceAction::SetDailyVolumeLimit,
+            [bridge_ptr, gov](uint64_t limit) { return bridge_ptr->set_daily_volume_limit(gov, limit); });
+        governance->bindAction(deployer, GovernanceAction::SetAccountVolumeLimit,
+            [bridge_ptr, gov](uint64_t limit) { return bridge_ptr->set_account_volume_limit(gov, limit); });
+    }
+
     void initialize_system(const std::string& admin) {
         logger->info("Initializing QOracle system...");
         
@@ -823,6 +1847,105 @@ public:
         logger->security("All admin keys burned - system now immutable");
     }
 
+    // Execute a block of BKPY/qBTC/qUSD transactions in parallel with
+    // results identical to applying them one by one in block order
+    qOracle::BlockResult execute_block(const std::vector<qOracle::BlockTx>& txs) {
+        // Proposal deadlines move on the block heartbeat
+        governance->tick();
+        
+        // Netted swaps whose epoch has closed land in this block's commit
+        bridge->settle_if_due(std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        
+        std::vector<bool> authorized(txs.size(), false);
+        for (size_t i = 0; i < txs.size(); ++i) {
+            const auto& tx = txs[i];
+            switch (tx.token) {
+                case qOracleConfig::TOKEN_BKPY: authorized[i] = bkpy_token->admits(tx); break;
+                case qOracleConfig::TOKEN_QBTC: authorized[i] = qbtc_token->admits(tx); break;
+                case qOracleConfig::TOKEN_QUSD: authorized[i] = qusd_token->admits(tx); break;
+                default: break;
+            }
+        }
+        
+        std::vector<qOracle::BlockLedger> ledgers = {
+            bkpy_token->block_ledger(), qbtc_token->block_ledger(), qusd_token->block_ledger()
+        };
+        // The executor holds the stripes of every account in the block. In
+        // LockFree mode single transfers skip stripes, so with LEDGER_MODE
+        // LockFree the caller must not run transfer() alongside a block.
+        auto result = block_executor->execute(txs, ledgers, authorized);
+        
+        static const char* SYMBOLS[] = {"BKPY", "qBTC", "qUSD"};
+        static const qOracle::EventType KINDS[] = {
+            qOracle::EventType::Transfer, qOracle::EventType::Mint, qOracle::EventType::Burn
+        };
+        size_t applied = 0;
+        for (size_t i = 0; i < txs.size(); ++i) {
+            if (!result.success[i]) continue;
+            ++applied;
+            const auto& tx = txs[i];
+            std::string from = tx.kind == qOracle::TxKind::Mint ? "" : address_registry->address(tx.from);
+            std::string to = tx.kind == qOracle::TxKind::Burn ? "" : address_registry->address(tx.to);
+            uint64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            event_store->append(KINDS[static_cast<uint8_t>(tx.kind)], now, SYMBOLS[tx.token], from, to, tx.amount);
+        }
+        
+        logger->info("Block executed: " + std::to_string(applied) + "/" + std::to_string(txs.size()) +
+                    " transactions applied in " + std::to_string(result.waves) + " waves, " +
+                    std::to_string(result.executions) + " executions (" +
+                    std::to_string(result.serial_executions) + " serial)");
+        
+        // Commit the block's balances so replicas can compare roots per block
+        uint64_t epoch = commit_epoch();
+        auto roots = state_roots();
+        logger->info("Block committed at epoch " + std::to_string(epoch) + ", state roots: BKPY " +
+                    qOracle::to_hex(roots[0]) + " qBTC " + qOracle::to_hex(roots[1]) + " qUSD " + qOracle::to_hex(roots[2]));
+        return result;
+    }
+
+    // Commit all three ledgers together so their epochs stay aligned with
+    // block height; returns the new epoch
+    uint64_t commit_epoch() {
+        std::lock_guard<qOracle::ProfiledMutex> lock(commit_mutex);
+        qOracle::WorkerPool* pool = &block_executor->workers();
+        bkpy_token->commit_epoch(pool);
+        qbtc_token->commit_epoch(pool);
+        return qusd_token->commit_epoch(pool);
+    }
+
+    // Same history depth on every ledger, so at_epoch() reaches equally far on each
+    void set_snapshot_retention(const std::string& admin, size_t epochs) {
+        bkpy_token->set_snapshot_retention(admin, epochs);
+        qbtc_token->set_snapshot_retention(admin, epochs);
+        qusd_token->set_snapshot_retention(admin, epochs);
+    }
+
+    // Merkle roots of the BKPY, qBTC and qUSD ledgers at the last commit, indexed like BlockTx::token
+    std::array<qOracle::StateHash, 3> state_roots() const {
+        return {bkpy_token->state_root(), qbtc_token->state_root(), qusd_token->state_root()};
+    }
+
+    LedgerMetrics get_ledger_metrics() const {
+        LedgerMetrics metrics;
+        metrics.bkpy = bkpy_token->ledger_stats();
+        metrics.qbtc = qbtc_token->ledger_stats();
+        metrics.qusd = qusd_token->ledger_stats();
+        metrics.registered_accounts = address_registry->size();
+        metrics.registry_bytes = address_registry->memory_bytes();
+        metrics.snapshot_nodes = bkpy_token->snapshot_nodes() + qbtc_token->snapshot_nodes() +
+                                 qusd_token->snapshot_nodes();
+        metrics.snapshot_bytes = bkpy_token->snapshot_bytes() + qbtc_token->snapshot_bytes() +
+                                 qusd_token->snapshot_bytes();
+        metrics.total_ledger_bytes = metrics.bkpy.ledger_bytes + metrics.qbtc.ledger_bytes +
+                                     metrics.qusd.ledger_bytes + metrics.snapshot_bytes + metrics.registry_bytes;
+        if (metrics.registered_accounts) {
+            metrics.bytes_per_account = metrics.total_ledger_bytes / metrics.registered_accounts;
+        }
+        return metrics;
+    }
+
     void get_system_status() const {
         logger->info("=== QOracle System Status ===");
         logger->info("Oracle Committee: " + std::string(oracle_committee->isInitialized() ? "ACTIVE" : "INACTIVE"));
@@ -835,6 +1958,26 @@ public:
         auto current_price = oracle_committee->get_current_price();
         logger->info("Current BTC Price: " + std::to_string(current_price.price) + 
                     " at " + std::to_string(current_price.timestamp));
+        
+        logger->info("Supply: " + BankonPythaiToken::format_amount(bkpy_token->totalSupply()) + " BKPY, " +
+                    QBTCSynthetic::format_amount(qbtc_token->totalSupply()) + " qBTC, " +
+                    QUSDStablecoin::format_amount(qusd_token->totalSupply()) + " qUSD");
+        
+        auto metrics = get_ledger_metrics();
+        logger->info("Ledger Memory: " + std::to_string(metrics.total_ledger_bytes) + " bytes, " +
+                    std::to_string(metrics.bytes_per_account) + " bytes/account over " +
+                    std::to_string(metrics.registered_accounts) + " accounts, snapshots " +
+                    std::to_string(metrics.snapshot_bytes) + " bytes over " +
+                    std::to_string(bkpy_token->snapshot_retention()) + " retained epochs");
+        
+        std::string locks = lock_profile();
+        if (!locks.empty()) logger->info("Most contended locks:\n" + locks);
+    }
+    
+    // Contention per named lock, worst first; empty unless built with
+    // QORACLE_LOCK_PROFILING=1
+    std::string lock_profile(size_t top = 5) const {
+        return qOracle::format_lock_report(qOracle::lock_report(top));
     }
     
     // Get component references for external access
@@ -844,9 +1987,14 @@ public:
     QUSDStablecoin* get_qusd_token() { return qusd_token.get(); }
     CrossChainBridge* get_bridge() { return bridge.get(); }
     QnosisMultisig* get_governance() { return governance.get(); }
+    qOracle::EventStore* get_event_store() { return event_store.get(); }
+    qOracle::AddressRegistry* get_address_registry() { return address_registry.get(); }
 };
 
 // ========================== MAIN FUNCTION ==========================
+// Tools that embed the system (benchmarks, load generation) define
+// QORACLE_NO_MAIN and include this file
+#ifndef QORACLE_NO_MAIN
 int main() {
     try {
         // Configuration
@@ -889,4 +2037,5 @@ int main() {
     }
     
     return 0;
-} 
\ No newline at end of file
+}
+#endif // QORACLE_NO_MAIN
@@ -0,0 +1,251 @@
+/*
+ * qOracle Ledger Stress Test
+ * Concurrent transfers, batches, mints and burns against the supply invariant
+ *
+ * Worker threads hammer a BKPY and a qUSD ledger with a random mix of
+ * single transfers, transfer_batch and multi_transfer in both batch
+ * modes, and authority mints and burns, while a committer thread keeps
+ * publishing snapshot epochs. Half of all transfers touch a handful of
+ * hot accounts so debits race on the same balances. Each ledger mode
+ * (Striped, LockFree) gets a fresh pair of tokens.
+ *
+ * Once the workers stop, the sum of every live balance must equal
+ * totalSupply(), and a final commit's snapshot must agree with the live
+ * balances. Any mismatch is reported and the process exits non-zero.
+ *
+ * A last run mints and burns qUSD until its lifetime mints pass 2^64
+ * units while the supply stays at 500 qUSD, so the sharded supply
+ * counter must stay exact across wraparound.
+ *
+ * Build:  g++ -std=c++17 -O2 -o qOracle_StressTest qOracle_StressTest.cpp -lcrypto -lpthread
+ * Run:    ./run_stress_test.sh [--threads n] [--ops n] [--quick]
+ *
+ * License: Qubic Anti-Military License
+ */
+
+#define QORACLE_NO_MAIN
+#include "qOracle_Production_RC2.cpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace stress {
+
+const std::string DEPLOYER = "ST1SJ3DTE5DN7X54YDH5D64R3BCB6A2AG2ZQ8YPD5";
+const std::string AUTHORITY = "ST2STRESSBRIDGEAUTHORITY0000000000000000";
+
+struct Options {
+    unsigned threads = 8;
+    uint64_t ops = 20000;           // Per thread and ledger mode
+    size_t accounts = 1000;
+    size_t hot_accounts = 8;
+    uint64_t funding = 1000000000ULL;   // Per account and token
+};
+
+// Deterministic per-thread stream
+struct XorShift {
+    uint64_t state;
+    explicit XorShift(uint64_t seed) : state(seed ? seed : 1) {}
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+struct Outcome {
+    std::atomic<uint64_t> applied{0};
+    std::atomic<uint64_t> rejected{0};
+    void count(bool ok) { (ok ? applied : rejected).fetch_add(1, std::memory_order_relaxed); }
+};
+
+template <typename Token>
+uint64_t live_sum(const Token& token, const qOracle::AddressRegistry& registry) {
+    uint64_t sum = 0;
+    for (size_t id = 0; id < registry.size(); ++id) sum += token.balanceOf(static_cast<qOracle::AccountId>(id));
+    return sum;
+}
+
+template <typename Token>
+uint64_t snapshot_sum(const Token& token) {
+    uint64_t sum = 0;
+    token.snapshot().for_each([&](qOracle::AccountId, uint64_t balance) { sum += balance; });
+    return sum;
+}
+
+// Check the invariants on one quiesced token; false on any violation
+template <typename Token>
+bool verify(const char* mode, Token& token, const qOracle::AddressRegistry& registry) {
+    uint64_t live = live_sum(token, registry);
+    uint64_t supply = token.totalSupply();
+    token.commit_epoch();
+    uint64_t committed = snapshot_sum(token);
+    bool ok = live == supply && committed == live;
+    std::fprintf(stderr, "  %-8s %-5s sum %llu supply %llu snapshot %llu  %s\n", mode, token.symbol().c_str(),
+                 static_cast<unsigned long long>(live), static_cast<unsigned long long>(supply),
+                 static_cast<unsigned long long>(committed), ok ? "ok" : "VIOLATION");
+    return ok;
+}
+
+bool run_mode(qOracle::LedgerMode mode, const Options& options) {
+    const char* mode_name = mode == qOracle::LedgerMode::Striped ? "striped" : "lockfree";
+    auto registry = std::make_shared<qOracle::AddressRegistry>();
+    auto logger = std::make_shared<ThreadSafeLogger>("qoracle_stress.log");
+
+    BankonPythaiToken bkpy(DEPLOYER, registry, logger, mode);
+    QUSDStablecoin qusd(DEPLOYER, AUTHORITY, registry, logger, mode);
+    bkpy.finalizeLaunch(DEPLOYER);
+    qusd.finalizeLaunch(DEPLOYER);
+    bkpy.mint_initial_supply(DEPLOYER);
+
+    qOracle::AccountId authority = registry->intern(AUTHORITY);
+    qOracle::AccountId admin = registry->intern(DEPLOYER);
+    std::vector<qOracle::AccountId> ids;
+    std::vector<qOracle::TransferLeg> funding;
+    for (size_t i = 0; i < options.accounts; ++i) {
+        ids.push_back(registry->intern("STRESS" + std::to_string(i)));
+        funding.push_back({ids.back(), options.funding});
+        qusd.mint(authority, ids.back(), options.funding);
+    }
+    if (bkpy.transfer_batch(admin, funding).applied != funding.size()) {
+        std::fprintf(stderr, "  %s: funding batch rejected\n", mode_name);
+        return false;
+    }
+
+    Outcome transfers, batches, supply_changes;
+    std::atomic<bool> stop{false};
+    std::thread committer([&] {
+        while (!stop.load()) {
+            bkpy.commit_epoch();
+            qusd.commit_epoch();
+            std::this_thread::yield();
+        }
+    });
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < options.threads; ++t) {
+        workers.emplace_back([&, t] {
+            XorShift rng(0x9E3779B97F4A7C15ULL * (t + 1));
+            auto pick = [&] {
+                uint64_t r = rng.next();
+                size_t n = (r & 1) ? options.hot_accounts : options.accounts;
+                return ids[(r >> 1) % n];
+            };
+            for (uint64_t i = 0; i < options.ops; ++i) {
+                uint64_t roll = rng.next() % 100;
+                // Large enough that hot senders run dry and debits race to underflow
+                uint64_t amount = 1 + rng.next() % (options.funding / 2);
+                auto batch_mode = (rng.next() & 1) ? qOracle::BatchMode::AllOrNothing : qOracle::BatchMode::BestEffort;
+                if (roll < 45) {
+                    transfers.count(bkpy.transfer(pick(), pick(), amount));
+                } else if (roll < 60) {
+                    std::vector<qOracle::TransferLeg> legs(1 + rng.next() % 8);
+                    for (auto& leg : legs) leg = {pick(), amount};
+                    batches.count(bkpy.transfer_batch(pick(), legs, batch_mode).applied > 0);
+                } else if (roll < 70) {
+                    std::vector<qOracle::TransferOrder> orders(2 + rng.next() % 7);
+                    for (auto& order : orders) order = {pick(), pick(), amount};
+                    batches.count(bkpy.multi_transfer(orders, batch_mode).applied > 0);
+                } else if (roll < 85) {
+                    transfers.count(qusd.transfer(pick(), pick(), amount));
+                } else if (roll < 93) {
+                    supply_changes.count(qusd.mint(authority, pick(), amount));
+                } else {
+                    supply_changes.count(qusd.burn(authority, pick(), amount));
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    stop.store(true);
+    committer.join();
+
+    std::fprintf(stderr, "%s: %u threads, transfers %llu/%llu, batches %llu/%llu, mints+burns %llu/%llu applied\n",
+                 mode_name, options.threads,
+                 static_cast<unsigned long long>(transfers.applied.load()),
+                 static_cast<unsigned long long>(transfers.applied.load() + transfers.rejected.load()),
+                 static_cast<unsigned long long>(batches.applied.load()),
+                 static_cast<unsigned long long>(batches.applied.load() + batches.rejected.load()),
+                 static_cast<unsigned long long>(supply_changes.applied.load()),
+                 static_cast<unsigned long long>(supply_changes.applied.load() + supply_changes.rejected.load()));
+    bool ok = verify(mode_name, bkpy, *registry);
+    ok = verify(mode_name, qusd, *registry) && ok;
+    return ok;
+}
+
+// Lifetime qUSD mints of 15-decimal units pass 2^64 after ~18,446 qUSD.
+// Threads share 36 mint-then-burn rounds of 500 qUSD (18,000 qUSD each
+// way) and one extra 500 qUSD mint, so lifetime mints wrap 2^64 once
+// while lifetime burns do not, and the supply must read 500 qUSD.
+bool run_wraparound(const Options& options) {
+    const uint64_t unit = 1000000000000000ULL;              // 1 qUSD
+    const uint64_t round = 500 * unit;
+    const uint64_t rounds = 36;
+    auto registry = std::make_shared<qOracle::AddressRegistry>();
+    auto logger = std::make_shared<ThreadSafeLogger>("qoracle_stress.log");
+    QUSDStablecoin qusd(DEPLOYER, AUTHORITY, registry, logger);
+    qusd.finalizeLaunch(DEPLOYER);
+    qOracle::AccountId authority = registry->intern(AUTHORITY);
+
+    std::vector<qOracle::AccountId> ids;
+    for (unsigned t = 0; t < options.threads; ++t) ids.push_back(registry->intern("WRAP" + std::to_string(t)));
+
+    Outcome supply_changes;
+    supply_changes.count(qusd.mint(authority, ids[0], round));
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < options.threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (uint64_t r = t; r < rounds; r += options.threads) {
+                supply_changes.count(qusd.mint(authority, ids[t], round));
+                supply_changes.count(qusd.burn(authority, ids[t], round));
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    std::fprintf(stderr, "wraparound: %u threads, lifetime qUSD mints past 2^64 units, mints+burns %llu/%llu applied\n",
+                 options.threads, static_cast<unsigned long long>(supply_changes.applied.load()),
+                 static_cast<unsigned long long>(supply_changes.applied.load() + supply_changes.rejected.load()));
+    bool ok = verify("wrap", qusd, *registry) && qusd.totalSupply() == round && qusd.totalSupplyExact() == round;
+    if (!ok) {
+        std::fprintf(stderr, "  wrap     supply %llu exact %llu expected %llu  VIOLATION\n",
+                     static_cast<unsigned long long>(qusd.totalSupply()),
+                     static_cast<unsigned long long>(qusd.totalSupplyExact()),
+                     static_cast<unsigned long long>(round));
+    }
+    return ok;
+}
+
+} // namespace stress
+
+int main(int argc, char** argv) {
+    stress::Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--quick") {
+            options.ops = 2000;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            options.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (arg == "--ops" && i + 1 < argc) {
+            options.ops = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            std::fprintf(stderr, "usage: %s [--threads n] [--ops per_thread] [--quick]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (options.threads == 0) options.threads = 1;
+
+    bool ok = true;
+    try {
+        for (qOracle::LedgerMode mode : {qOracle::LedgerMode::Striped, qOracle::LedgerMode::LockFree}) {
+            ok = stress::run_mode(mode, options) && ok;
+        }
+        ok = stress::run_wraparound(options) && ok;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "Stress test failed: %s\n", e.what());
+        return 1;
+    }
+    std::fprintf(stderr, ok ? "PASS: supply conserved in every mode\n" : "FAIL: supply invariant violated\n");
+    return ok ? 0 : 1;
+}
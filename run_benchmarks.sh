@@ -0,0 +1,36 @@
+#!/bin/bash
+
+# qOracle Microbenchmarks
+# Builds qOracle_Benchmarks.cpp and runs it in a scratch directory
+#
+# Usage: ./run_benchmarks.sh [--quick] [--filter <substring>] [--seconds <s>] [--out <file.json>]
+# Results are written as JSON to --out (default: benchmark_results.json);
+# a readable table goes to stderr.
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+CXX="${CXX:-g++}"
+CXXFLAGS="${CXXFLAGS:--O2}"
+OUT="benchmark_results.json"
+
+ARGS=()
+while [ $# -gt 0 ]; do
+    case "$1" in
+        --out) OUT="$2"; shift 2 ;;
+        *) ARGS+=("$1"); shift ;;
+    esac
+done
+OUT="$(cd "$(dirname "$OUT")" && pwd)/$(basename "$OUT")"
+
+WORK_DIR="$(mktemp -d)"
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+echo "[INFO] Building qOracle_Benchmarks..." >&2
+"$CXX" -std=c++17 $CXXFLAGS -I"$SCRIPT_DIR" -o "$WORK_DIR/qOracle_Benchmarks" \
+    "$SCRIPT_DIR/qOracle_Benchmarks.cpp" -lcrypto -lpthread
+
+# The system under test writes its log and event segments to the working directory
+cd "$WORK_DIR"
+./qOracle_Benchmarks "${ARGS[@]}" --out "$OUT"
+echo "[SUCCESS] Results written to $OUT" >&2
@@ -0,0 +1,41 @@
+#!/bin/bash
+
+# qOracle Load Generator
+# Builds qOracle_LoadGen.cpp and runs an offered-load sweep in a scratch directory
+#
+# Usage: ./run_loadgen.sh [--quick] [--rates r1,r2,...] [--threads n] [--out <file.json>] ...
+# Results are written as JSON to --out (default: loadgen_results.json);
+# a readable table per step goes to stderr. --help lists every option.
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+CXX="${CXX:-g++}"
+CXXFLAGS="${CXXFLAGS:--O2}"
+OUT="loadgen_results.json"
+
+ARGS=()
+while [ $# -gt 0 ]; do
+    case "$1" in
+        --out) OUT="$2"; shift 2 ;;
+        --help) HELP=1; shift ;;
+        *) ARGS+=("$1"); shift ;;
+    esac
+done
+OUT="$(cd "$(dirname "$OUT")" && pwd)/$(basename "$OUT")"
+
+WORK_DIR="$(mktemp -d)"
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+echo "[INFO] Building qOracle_LoadGen..." >&2
+"$CXX" -std=c++17 $CXXFLAGS -I"$SCRIPT_DIR" -o "$WORK_DIR/qOracle_LoadGen" \
+    "$SCRIPT_DIR/qOracle_LoadGen.cpp" -lcrypto -lpthread
+
+# The system under test writes its log and event segments to the working directory
+cd "$WORK_DIR"
+if [ -n "$HELP" ]; then
+    ./qOracle_LoadGen --help
+    exit 0
+fi
+./qOracle_LoadGen "${ARGS[@]}" --out "$OUT"
+echo "[SUCCESS] Results written to $OUT" >&2
@@ -0,0 +1,25 @@
+#!/bin/bash
+
+# qOracle Ledger Stress Test
+# Builds qOracle_StressTest.cpp and runs it in a scratch directory
+#
+# Usage: ./run_stress_test.sh [--threads n] [--ops n] [--quick]
+# Exits non-zero if any ledger mode breaks the supply invariant.
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+CXX="${CXX:-g++}"
+CXXFLAGS="${CXXFLAGS:--O2}"
+
+WORK_DIR="$(mktemp -d)"
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+echo "[INFO] Building qOracle_StressTest..." >&2
+"$CXX" -std=c++17 $CXXFLAGS -I"$SCRIPT_DIR" -o "$WORK_DIR/qOracle_StressTest" \
+    "$SCRIPT_DIR/qOracle_StressTest.cpp" -lcrypto -lpthread
+
+# The ledgers write their log to the working directory
+cd "$WORK_DIR"
+./qOracle_StressTest "$@"
+echo "[SUCCESS] Supply conserved under concurrent load" >&2